@@ -166,6 +166,14 @@ void BraveBrowserProcessImpl::Init() {
   InitSystemRequestHandlerCallback();
 }
 
+void BraveBrowserProcessImpl::StartTearDown() {
+  // Must happen before local state is committed by the base class.
+  if (brave_p3a_service_)
+    brave_p3a_service_->Shutdown();
+
+  BrowserProcessImpl::StartTearDown();
+}
+
 brave_component_updater::BraveComponent::Delegate*
 BraveBrowserProcessImpl::brave_component_updater_delegate() {
   if (!brave_component_updater_delegate_)
@@ -76,6 +76,9 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   ProfileManager* profile_manager() override;
   NotificationPlatformBridge* notification_platform_bridge() override;
 
+  // BrowserProcessImpl overrides:
+  void StartTearDown() override;
+
   void StartBraveServices();
   brave_shields::AdBlockService* ad_block_service();
   brave_shields::AdBlockCustomFiltersService* ad_block_custom_filters_service();
@@ -8,14 +8,19 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/task_runner_util.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/extensions/api/brave_action_api.h"
 #include "brave/browser/webcompat_reporter/webcompat_reporter_dialog.h"
 #include "brave/common/extensions/api/brave_shields.h"
 #include "brave/common/extensions/extension_constants.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -32,6 +37,7 @@
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/web_contents.h"
 #include "extensions/browser/extension_util.h"
+#include "url/gurl.h"
 
 using brave_shields::BraveShieldsWebContentsObserver;
 using brave_shields::ControlType;
@@ -46,26 +52,46 @@ namespace {
 const char kInvalidUrlError[] = "Invalid URL.";
 const char kInvalidControlTypeError[] = "Invalid ControlType.";
 
-}  // namespace
+::brave_shields::CosmeticResourcesVersion GetCosmeticResourcesVersion() {
+  ::brave_shields::CosmeticResourcesVersion version;
+  version.default_generation =
+      g_brave_browser_process->ad_block_service()->engine_generation();
+  g_brave_browser_process->ad_block_regional_service_manager()->GetGenerations(
+      &version.regional_lists_generation, &version.regional_engines_generation);
+  version.custom_generation =
+      g_brave_browser_process->ad_block_custom_filters_service()
+          ->engine_generation();
+  return version;
+}
 
+::brave_shields::AdBlockCosmeticResourcesCache* GetCosmeticResourcesCache() {
+  static base::NoDestructor<::brave_shields::AdBlockCosmeticResourcesCache>
+      cache;
+  return cache.get();
+}
 
-ExtensionFunction::ResponseAction
-BraveShieldsUrlCosmeticResourcesFunction::Run() {
-  std::unique_ptr<brave_shields::UrlCosmeticResources::Params> params(
-      brave_shields::UrlCosmeticResources::Params::Create(*args_));
-  EXTENSION_FUNCTION_VALIDATE(params.get());
+// Runs on the ad-block task runner. The engines only look at the hostname of
+// |url|, so their merged resources are cached per host.
+base::Optional<base::Value> GetUrlCosmeticResources(const std::string& url) {
+  const std::string host = GURL(url).host();
+  // Read before querying the engines, so that resources computed while one of
+  // them changes are not served for the new version.
+  const ::brave_shields::CosmeticResourcesVersion version =
+      GetCosmeticResourcesVersion();
+  base::Value cached_resources;
+  if (GetCosmeticResourcesCache()->Get(host, version, &cached_resources))
+    return cached_resources;
 
   base::Optional<base::Value> resources = g_brave_browser_process->
-      ad_block_service()->UrlCosmeticResources(params->url);
+      ad_block_service()->UrlCosmeticResources(url);
 
   if (!resources || !resources->is_dict()) {
-    return RespondNow(Error(
-        "Url-specific cosmetic resources could not be returned"));
+    return base::nullopt;
   }
 
   base::Optional<base::Value> regional_resources = g_brave_browser_process->
       ad_block_regional_service_manager()->
-          UrlCosmeticResources(params->url);
+          UrlCosmeticResources(url);
 
   if (regional_resources && regional_resources->is_dict()) {
     ::brave_shields::MergeResourcesInto(
@@ -76,7 +102,7 @@ BraveShieldsUrlCosmeticResourcesFunction::Run() {
 
   base::Optional<base::Value> custom_resources = g_brave_browser_process->
       ad_block_custom_filters_service()->
-          UrlCosmeticResources(params->url);
+          UrlCosmeticResources(url);
 
   if (custom_resources && custom_resources->is_dict()) {
     ::brave_shields::MergeResourcesInto(
@@ -85,29 +111,22 @@ BraveShieldsUrlCosmeticResourcesFunction::Run() {
             true);
   }
 
-  auto result_list = std::make_unique<base::ListValue>();
-
-  result_list->Append(std::move(*resources));
-
-  return RespondNow(ArgumentList(std::move(result_list)));
+  GetCosmeticResourcesCache()->Put(host, version, *resources);
+  return resources;
 }
 
-ExtensionFunction::ResponseAction
-BraveShieldsHiddenClassIdSelectorsFunction::Run() {
-  std::unique_ptr<brave_shields::HiddenClassIdSelectors::Params> params(
-      brave_shields::HiddenClassIdSelectors::Params::Create(*args_));
-  EXTENSION_FUNCTION_VALIDATE(params.get());
-
+// Runs on the ad-block task runner. Returns nullptr if the default or the
+// custom engine couldn't return its selectors.
+std::unique_ptr<base::ListValue> GetHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
   base::Optional<base::Value> hide_selectors = g_brave_browser_process->
-      ad_block_service()->HiddenClassIdSelectors(params->classes,
-                                                 params->ids,
-                                                 params->exceptions);
+      ad_block_service()->HiddenClassIdSelectors(classes, ids, exceptions);
 
   base::Optional<base::Value> regional_selectors = g_brave_browser_process->
       ad_block_regional_service_manager()->
-        HiddenClassIdSelectors(params->classes,
-                               params->ids,
-                               params->exceptions);
+        HiddenClassIdSelectors(classes, ids, exceptions);
 
   if (hide_selectors && hide_selectors->is_list()) {
     if (regional_selectors && regional_selectors->is_list()) {
@@ -123,16 +142,79 @@ BraveShieldsHiddenClassIdSelectorsFunction::Run() {
 
   base::Optional<base::Value> custom_selectors = g_brave_browser_process->
       ad_block_custom_filters_service()->
-          HiddenClassIdSelectors(params->classes,
-                                 params->ids,
-                                 params->exceptions);
+          HiddenClassIdSelectors(classes, ids, exceptions);
+
+  if (!hide_selectors || !hide_selectors->is_list() || !custom_selectors ||
+      !custom_selectors->is_list()) {
+    return nullptr;
+  }
 
   auto result_list = std::make_unique<base::ListValue>();
 
   result_list->Append(std::move(*hide_selectors));
   result_list->Append(std::move(*custom_selectors));
 
-  return RespondNow(ArgumentList(std::move(result_list)));
+  return result_list;
+}
+
+}  // namespace
+
+
+ExtensionFunction::ResponseAction
+BraveShieldsUrlCosmeticResourcesFunction::Run() {
+  std::unique_ptr<brave_shields::UrlCosmeticResources::Params> params(
+      brave_shields::UrlCosmeticResources::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  base::PostTaskAndReplyWithResult(
+      g_brave_browser_process->ad_block_service()->GetTaskRunner().get(),
+      FROM_HERE, base::BindOnce(&GetUrlCosmeticResources, params->url),
+      base::BindOnce(
+          &BraveShieldsUrlCosmeticResourcesFunction::OnUrlCosmeticResources,
+          this));
+  return RespondLater();
+}
+
+void BraveShieldsUrlCosmeticResourcesFunction::OnUrlCosmeticResources(
+    base::Optional<base::Value> resources) {
+  if (!resources || !resources->is_dict()) {
+    Respond(Error("Url-specific cosmetic resources could not be returned"));
+    return;
+  }
+
+  auto result_list = std::make_unique<base::ListValue>();
+
+  result_list->Append(std::move(*resources));
+
+  Respond(ArgumentList(std::move(result_list)));
+}
+
+ExtensionFunction::ResponseAction
+BraveShieldsHiddenClassIdSelectorsFunction::Run() {
+  std::unique_ptr<brave_shields::HiddenClassIdSelectors::Params> params(
+      brave_shields::HiddenClassIdSelectors::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  base::PostTaskAndReplyWithResult(
+      g_brave_browser_process->ad_block_service()->GetTaskRunner().get(),
+      FROM_HERE,
+      base::BindOnce(&GetHiddenClassIdSelectors, std::move(params->classes),
+                     std::move(params->ids), std::move(params->exceptions)),
+      base::BindOnce(
+          &BraveShieldsHiddenClassIdSelectorsFunction::OnHiddenClassIdSelectors,
+          this));
+  return RespondLater();
+}
+
+void BraveShieldsHiddenClassIdSelectorsFunction::OnHiddenClassIdSelectors(
+    std::unique_ptr<base::ListValue> result_list) {
+  if (!result_list) {
+    result_list = std::make_unique<base::ListValue>();
+    result_list->Append(base::Value(base::Value::Type::LIST));
+    result_list->Append(base::Value(base::Value::Type::LIST));
+  }
+
+  Respond(ArgumentList(std::move(result_list)));
 }
 
 
@@ -9,16 +9,22 @@
 #include <string>
 
 #include "base/base64url.h"
+#include "base/feature_list.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "content/public/browser/browser_thread.h"
 #include "extensions/common/url_pattern.h"
@@ -27,28 +33,32 @@
 namespace brave {
 
 void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
+  base::ElapsedTimer timer;
   bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
+  const brave_shields::AdBlockRequest request(
+      ctx->request_url, ctx->resource_type, ctx->tab_origin.host(),
+      ctx->IsThirdParty());
   if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly,
+          request, &did_match_exception, &ctx->cancel_request_explicitly,
           &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly,
                                        &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly,
                                        &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   }
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.OnBeforeURLRequest_AdBlockTP", timer.Elapsed(),
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
 }
 
 void OnShouldBlockAdResult(const ResponseCallback& next_callback,
@@ -75,6 +85,19 @@ void OnBeforeURLRequestAdBlockTP(
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockParallelMatching)) {
+    // The engines are shared read-only, so matches for different requests
+    // can run concurrently on the thread pool.
+    base::PostTaskAndReply(
+        FROM_HERE,
+        {base::ThreadPool(), base::TaskPriority::USER_BLOCKING,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
+        base::BindOnce(&OnShouldBlockAdResult, next_callback, ctx));
+    return;
+  }
+
   g_brave_browser_process->ad_block_service()->GetTaskRunner()
       ->PostTaskAndReply(FROM_HERE,
                          base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
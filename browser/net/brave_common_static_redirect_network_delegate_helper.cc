@@ -7,12 +7,14 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/host_dispatch_table.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
@@ -46,25 +48,40 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+enum class CommonStaticRedirect {
+  kUpdater,
+  kChromeCast,
+  kClients4,
+  kBugReporting,
+};
+
+HostDispatchTable BuildCommonStaticRedirectTable() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  HostDispatchTable table;
+  auto add = [&table](CommonStaticRedirect id, int schemes,
+                      base::StringPiece pattern,
+                      HostDispatchTable::MatchType match_type =
+                          HostDispatchTable::MatchType::kURL) {
+    table.Add(static_cast<int>(id), URLPattern(schemes, pattern), match_type);
+  };
+
+  // Update server checks happen from the profile context for admin policy
+  // installed extensions. Update server checks happen from the system context
+  // for normal update operations.
+  add(CommonStaticRedirect::kUpdater, URLPattern::SCHEME_HTTPS,
+      std::string(component_updater::kUpdaterJSONDefaultUrl) + "*");
+  add(CommonStaticRedirect::kUpdater, URLPattern::SCHEME_HTTP,
+      std::string(component_updater::kUpdaterJSONFallbackUrl) + "*");
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+  add(CommonStaticRedirect::kUpdater, URLPattern::SCHEME_HTTPS,
+      std::string(extension_urls::kChromeWebstoreUpdateURL) + "*");
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+  add(CommonStaticRedirect::kChromeCast, kHttpOrHttps, kChromeCastPrefix);
+  add(CommonStaticRedirect::kClients4, kHttpOrHttps, kClients4Prefix,
+      HostDispatchTable::MatchType::kHost);
+  add(CommonStaticRedirect::kBugReporting, kHttpOrHttps,
+      "*://bugs.chromium.org/p/chromium/issues/entry?*");
+  return table;
 }
 
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
@@ -114,41 +131,38 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     GURL* new_url) {
   DCHECK(new_url);
 
-  GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-  static URLPattern bugsChromium_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://bugs.chromium.org/p/chromium/issues/entry?*");
+  static const base::NoDestructor<HostDispatchTable> table(
+      BuildCommonStaticRedirectTable());
 
-  if (IsUpdaterURL(request_url)) {
-    auto update_host = GetUpdateURLHost();
-    if (!update_host.empty()) {
-      replacements.SetQueryStr(request_url.query_piece());
-      *new_url = GURL(update_host).ReplaceComponents(replacements);
+  GURL::Replacements replacements;
+  for (int id : table->Match(request_url)) {
+    switch (static_cast<CommonStaticRedirect>(id)) {
+      case CommonStaticRedirect::kUpdater: {
+        auto update_host = GetUpdateURLHost();
+        if (!update_host.empty()) {
+          replacements.SetQueryStr(request_url.query_piece());
+          *new_url = GURL(update_host).ReplaceComponents(replacements);
+        }
+        return net::OK;
+      }
+
+      case CommonStaticRedirect::kChromeCast:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr(kBraveRedirectorProxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      case CommonStaticRedirect::kClients4:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr(kBraveClients4Proxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      case CommonStaticRedirect::kBugReporting:
+        if (RewriteBugReportingURL(request_url, new_url))
+          return net::OK;
+        break;
     }
-    return net::OK;
-  }
-
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (bugsChromium_pattern.MatchesURL(request_url)) {
-    if (RewriteBugReportingURL(request_url, new_url))
-      return net::OK;
   }
 
   return net::OK;
@@ -107,4 +107,28 @@ TEST_F(BraveNetworkDelegateBaseTest, RetainTrackableSecurityHeaders) {
   EXPECT_TRUE(headers->HasHeader(kXSSProtectionHeader));
 }
 
+TEST_F(BraveNetworkDelegateBaseTest, RequestInfoThirdParty) {
+  brave::BraveRequestInfo same_host(GURL("http://www.firstparty.com/"));
+  same_host.tab_origin = GURL("http://www.firstparty.com/");
+  EXPECT_FALSE(same_host.IsThirdParty());
+
+  brave::BraveRequestInfo same_domain(GURL("https://cdn.firstparty.com/a.js"));
+  same_domain.tab_origin = GURL(kFirstPartyDomain);
+  EXPECT_FALSE(same_domain.IsThirdParty());
+
+  brave::BraveRequestInfo third_party(GURL(kThirdPartyDomain));
+  third_party.tab_origin = GURL(kFirstPartyDomain);
+  EXPECT_TRUE(third_party.IsThirdParty());
+
+  // Private registries count as separate sites.
+  brave::BraveRequestInfo private_registry(GURL("https://a.github.io/"));
+  private_registry.tab_origin = GURL("https://b.github.io/");
+  EXPECT_TRUE(private_registry.IsThirdParty());
+
+  // Hosts without a registrable domain only match themselves.
+  brave::BraveRequestInfo ip_address(GURL("http://127.0.0.1/"));
+  ip_address.tab_origin = GURL("http://127.0.0.2/");
+  EXPECT_TRUE(ip_address.IsThirdParty());
+}
+
 }  // namespace
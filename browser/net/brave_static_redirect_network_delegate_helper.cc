@@ -5,12 +5,11 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
-#include <algorithm>
 #include <memory>
-#include <string>
-#include <vector>
 
-#include "base/strings/string_piece_forward.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "brave/browser/net/host_dispatch_table.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -24,12 +23,62 @@ namespace {
 
 bool g_safebrowsing_api_endpoint_for_testing_ = false;
 
+enum class StaticRedirect {
+  kGeo,
+  kSafeBrowsing,
+  kSafeBrowsingFileCheck,
+  kCRXDownload,
+  kAutofill,
+  kCRLSet,
+  kWidevine,
+  kGoogleDownload,
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  kTranslate,
+  kTranslateLanguage,
+#endif
+};
+
 base::StringPiece GetSafeBrowsingEndpoint() {
   if (g_safebrowsing_api_endpoint_for_testing_)
     return kSafeBrowsingTestingEndpoint;
   return SAFEBROWSING_ENDPOINT;
 }
 
+HostDispatchTable BuildStaticRedirectTable() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  HostDispatchTable table;
+  auto add = [&table](StaticRedirect id, int schemes, base::StringPiece pattern,
+                      HostDispatchTable::MatchType match_type =
+                          HostDispatchTable::MatchType::kURL) {
+    table.Add(static_cast<int>(id), URLPattern(schemes, pattern), match_type);
+  };
+
+  add(StaticRedirect::kGeo, URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
+  add(StaticRedirect::kSafeBrowsing, URLPattern::SCHEME_HTTPS,
+      kSafeBrowsingPrefix, HostDispatchTable::MatchType::kHost);
+  add(StaticRedirect::kSafeBrowsingFileCheck, URLPattern::SCHEME_HTTPS,
+      kSafeBrowsingFileCheckPrefix, HostDispatchTable::MatchType::kHost);
+  add(StaticRedirect::kCRXDownload, kHttpOrHttps, kCRXDownloadPrefix);
+  add(StaticRedirect::kAutofill, URLPattern::SCHEME_HTTPS, kAutofillPrefix);
+  add(StaticRedirect::kCRLSet, kHttpOrHttps, kCRLSetPrefix1);
+  add(StaticRedirect::kCRLSet, kHttpOrHttps, kCRLSetPrefix2);
+  add(StaticRedirect::kCRLSet, kHttpOrHttps, kCRLSetPrefix3);
+  add(StaticRedirect::kCRLSet, kHttpOrHttps, kCRLSetPrefix4);
+  // Widevine entries are added ahead of the gvt1 and dl.google.com ones so
+  // that they take precedence over them.
+  add(StaticRedirect::kWidevine, kHttpOrHttps, kWidevineGvt1Prefix);
+  add(StaticRedirect::kGoogleDownload, kHttpOrHttps, "*://*.gvt1.com/*");
+  add(StaticRedirect::kWidevine, kHttpOrHttps, kWidevineGoogleDlPrefix);
+  add(StaticRedirect::kGoogleDownload, kHttpOrHttps, "*://dl.google.com/*");
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  add(StaticRedirect::kTranslate, URLPattern::SCHEME_HTTPS,
+      kTranslateElementJSPattern);
+  add(StaticRedirect::kTranslateLanguage, URLPattern::SCHEME_HTTPS,
+      kTranslateLanguagePattern);
+#endif
+  return table;
+}
+
 }  // namespace
 
 void SetSafeBrowsingEndpointForTesting(bool testing) {
@@ -51,142 +100,79 @@ int OnBeforeURLRequest_StaticRedirectWork(
 int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
+  static const base::NoDestructor<HostDispatchTable> table(
+      BuildStaticRedirectTable());
+
+  // Entries are tried in the order they were added to the table and the first
+  // one that applies to the request wins.
   GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingFileCheckPrefix);
-
-  // To-Do (@jumde) - Update the naming for the variables below
-  // https://github.com/brave/brave-browser/issues/10314
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
-  static URLPattern widevine_gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGvt1Prefix);
-  static URLPattern widevine_google_dl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGoogleDlPrefix);
+  for (int id : table->Match(request_url)) {
+    switch (static_cast<StaticRedirect>(id)) {
+      case StaticRedirect::kGeo:
+        *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+        return net::OK;
+
+      case StaticRedirect::kSafeBrowsing: {
+        auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
+        if (safebrowsing_endpoint.empty())
+          break;
+        replacements.SetHostStr(safebrowsing_endpoint);
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+      }
+
+      case StaticRedirect::kSafeBrowsingFileCheck:
+        // TODO(@fmarier): Re-enable download protection once we have
+        // truncated the list of metadata that it sends to the server
+        // (brave/brave-browser#6267).
+        //
+        // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
+        // *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      case StaticRedirect::kCRXDownload:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr("crxdownload.brave.com");
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      case StaticRedirect::kAutofill:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr(kBraveStaticProxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      case StaticRedirect::kCRLSet:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr("crlsets.brave.com");
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
+
+      // Widevine downloads are left alone rather than sent to the proxy.
+      case StaticRedirect::kWidevine:
+        return net::OK;
+
+      case StaticRedirect::kGoogleDownload:
+        replacements.SetSchemeStr("https");
+        replacements.SetHostStr(kBraveRedirectorProxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+        return net::OK;
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
+      case StaticRedirect::kTranslate:
+        replacements.SetQueryStr(request_url.query_piece());
+        replacements.SetPathStr(request_url.path_piece());
+        *new_url =
+          GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
+        return net::OK;
+
+      case StaticRedirect::kTranslateLanguage:
+        *new_url = GURL(kBraveTranslateLanguageEndpoint);
+        return net::OK;
 #endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
-  }
-
-  auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
-  if (!safebrowsing_endpoint.empty() &&
-      safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(safebrowsing_endpoint);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    // TODO(@fmarier): Re-enable download protection once we have
-    // truncated the list of metadata that it sends to the server
-    // (brave/brave-browser#6267).
-    //
-    // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
-    // *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    }
   }
 
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (gvt1_pattern.MatchesURL(request_url) &&
-      !widevine_gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (googleDl_pattern.MatchesURL(request_url) &&
-      !widevine_google_dl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
-  }
-#endif
-
   return net::OK;
 }
 
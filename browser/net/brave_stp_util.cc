@@ -18,20 +18,13 @@ base::flat_set<base::StringPiece>* TrackableSecurityHeaders() {
   return kTrackableSecurityHeaders.get();
 }
 
-void RemoveTrackableSecurityHeadersForThirdParty(
-    const GURL& request_url, const url::Origin& top_frame_origin,
+void RemoveTrackableSecurityHeaders(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers) {
   if (!original_response_headers && !override_response_headers->get()) {
     return;
   }
 
-  if (net::registry_controlled_domains::SameDomainOrHost(
-          request_url, top_frame_origin,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
-    return;
-  }
-
   if (!override_response_headers->get()) {
     *override_response_headers =
         new net::HttpResponseHeaders(original_response_headers->raw_headers());
@@ -41,4 +34,18 @@ void RemoveTrackableSecurityHeadersForThirdParty(
   }
 }
 
+void RemoveTrackableSecurityHeadersForThirdParty(
+    const GURL& request_url, const url::Origin& top_frame_origin,
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers) {
+  if (net::registry_controlled_domains::SameDomainOrHost(
+          request_url, top_frame_origin,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+    return;
+  }
+
+  RemoveTrackableSecurityHeaders(original_response_headers,
+                                 override_response_headers);
+}
+
 }  // namespace brave
@@ -16,6 +16,12 @@ namespace brave {
 
 base::flat_set<base::StringPiece>* TrackableSecurityHeaders();
 
+// Removes the trackable security headers, the caller is responsible for
+// checking that the request is third-party.
+void RemoveTrackableSecurityHeaders(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers);
+
 void RemoveTrackableSecurityHeadersForThirdParty(
     const GURL& request_url, const url::Origin& top_frame_origin,
     const net::HttpResponseHeaders* original_response_headers,
@@ -0,0 +1,103 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/host_dispatch_table.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+// Calls |visit| with every label of |host|, from the last one to the first,
+// for as long as it returns true. A trailing dot is ignored.
+template <typename Visitor>
+void VisitLabelsReversed(base::StringPiece host, Visitor visit) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  while (!host.empty()) {
+    const size_t dot = host.rfind('.');
+    const base::StringPiece label =
+        dot == base::StringPiece::npos ? host : host.substr(dot + 1);
+    if (!visit(label))
+      return;
+    host = dot == base::StringPiece::npos ? base::StringPiece()
+                                          : host.substr(0, dot);
+  }
+}
+
+}  // namespace
+
+HostDispatchTable::HostNode::HostNode() = default;
+HostDispatchTable::HostNode::~HostNode() = default;
+
+HostDispatchTable::HostDispatchTable() : root_(std::make_unique<HostNode>()) {}
+HostDispatchTable::HostDispatchTable(HostDispatchTable&& other) = default;
+HostDispatchTable& HostDispatchTable::operator=(HostDispatchTable&& other) =
+    default;
+HostDispatchTable::~HostDispatchTable() = default;
+
+void HostDispatchTable::Add(int id,
+                            const URLPattern& pattern,
+                            MatchType match_type) {
+  HostNode* node = root_.get();
+  VisitLabelsReversed(pattern.host(), [&node](base::StringPiece label) {
+    std::unique_ptr<HostNode>& child = node->children[label.as_string()];
+    if (!child)
+      child = std::make_unique<HostNode>();
+    node = child.get();
+    return true;
+  });
+
+  const size_t index = entries_.size();
+  entries_.push_back({id, pattern, match_type});
+  // An empty host with |match_subdomains| matches all hosts and ends up in the
+  // subdomain list of the root.
+  if (pattern.match_subdomains())
+    node->subdomains.push_back(index);
+  else
+    node->exact.push_back(index);
+}
+
+std::vector<int> HostDispatchTable::Match(const GURL& url) const {
+  std::vector<size_t> candidates(root_->subdomains);
+  const HostNode* node = root_.get();
+  bool reached_host = true;
+  VisitLabelsReversed(url.host_piece(), [&](base::StringPiece label) {
+    auto it = node->children.find(label);
+    if (it == node->children.end()) {
+      reached_host = false;
+      return false;
+    }
+    node = it->second.get();
+    candidates.insert(candidates.end(), node->subdomains.begin(),
+                      node->subdomains.end());
+    return true;
+  });
+  if (reached_host)
+    candidates.insert(candidates.end(), node->exact.begin(), node->exact.end());
+
+  std::vector<int> ids;
+  if (candidates.empty())
+    return ids;
+
+  // Candidates only share a host; the patterns decide about the rest.
+  std::sort(candidates.begin(), candidates.end());
+  for (size_t index : candidates) {
+    const Entry& entry = entries_[index];
+    const bool matches = entry.match_type == MatchType::kHost
+                             ? entry.pattern.MatchesHost(url)
+                             : entry.pattern.MatchesURL(url);
+    if (matches)
+      ids.push_back(entry.id);
+  }
+  return ids;
+}
+
+}  // namespace brave
@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_HOST_DISPATCH_TABLE_H_
+#define BRAVE_BROWSER_NET_HOST_DISPATCH_TABLE_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// A set of URLPatterns indexed by the host they apply to. Patterns are stored
+// in a reversed-label host trie ("com" -> "google" -> "dl"), so that a lookup
+// walks the labels of the request host once and only runs the full match on
+// the few patterns registered for that host or one of its parents, instead of
+// trying every pattern in turn.
+//
+// Every pattern is added with an id that callers use to dispatch on the
+// result. Build the table once and only look it up afterwards.
+class HostDispatchTable {
+ public:
+  enum class MatchType {
+    // URLPattern::MatchesURL()
+    kURL,
+    // URLPattern::MatchesHost(), which ignores the scheme and the path.
+    kHost,
+  };
+
+  HostDispatchTable();
+  HostDispatchTable(HostDispatchTable&& other);
+  HostDispatchTable& operator=(HostDispatchTable&& other);
+  ~HostDispatchTable();
+
+  void Add(int id,
+           const URLPattern& pattern,
+           MatchType match_type = MatchType::kURL);
+
+  // Returns the ids of the patterns matching |url|, in the order they were
+  // added.
+  std::vector<int> Match(const GURL& url) const;
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    int id;
+    URLPattern pattern;
+    MatchType match_type;
+  };
+
+  struct HostNode {
+    HostNode();
+    ~HostNode();
+
+    base::flat_map<std::string, std::unique_ptr<HostNode>, std::less<>>
+        children;
+    // Indices into |entries_| of the patterns for exactly this host...
+    std::vector<size_t> exact;
+    // ...and of the patterns for this host and all of its subdomains.
+    std::vector<size_t> subdomains;
+
+    DISALLOW_COPY_AND_ASSIGN(HostNode);
+  };
+
+  std::unique_ptr<HostNode> root_;
+  std::vector<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostDispatchTable);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_HOST_DISPATCH_TABLE_H_
@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/host_dispatch_table.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "brave/common/network_constants.h"
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave::HostDispatchTable;
+
+namespace {
+
+const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+}  // namespace
+
+TEST(HostDispatchTableTest, ExactHost) {
+  HostDispatchTable table;
+  table.Add(1, URLPattern(kHttpOrHttps, "*://dl.google.com/*"));
+
+  EXPECT_EQ(std::vector<int>({1}),
+            table.Match(GURL("https://dl.google.com/chrome/x.crx")));
+  EXPECT_TRUE(table.Match(GURL("https://www.dl.google.com/")).empty());
+  EXPECT_TRUE(table.Match(GURL("https://google.com/")).empty());
+  EXPECT_TRUE(table.Match(GURL("ftp://dl.google.com/")).empty());
+}
+
+TEST(HostDispatchTableTest, Subdomains) {
+  HostDispatchTable table;
+  table.Add(1, URLPattern(kHttpOrHttps, "*://*.gvt1.com/*"));
+
+  EXPECT_EQ(std::vector<int>({1}), table.Match(GURL("http://gvt1.com/")));
+  EXPECT_EQ(std::vector<int>({1}),
+            table.Match(GURL("https://r1---sn.gvt1.com/edgedl/a")));
+  EXPECT_TRUE(table.Match(GURL("https://gvt1.com.example/")).empty());
+  EXPECT_TRUE(table.Match(GURL("https://notgvt1.com/")).empty());
+}
+
+TEST(HostDispatchTableTest, PathAndSchemeStillApply) {
+  HostDispatchTable table;
+  table.Add(1, URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix));
+
+  EXPECT_EQ(std::vector<int>({1}),
+            table.Match(GURL("https://www.gstatic.com/autofill/a")));
+  EXPECT_TRUE(table.Match(GURL("https://www.gstatic.com/other")).empty());
+  EXPECT_TRUE(table.Match(GURL("http://www.gstatic.com/autofill/a")).empty());
+}
+
+TEST(HostDispatchTableTest, HostMatchIgnoresPath) {
+  HostDispatchTable table;
+  table.Add(1, URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+            HostDispatchTable::MatchType::kHost);
+
+  EXPECT_EQ(std::vector<int>({1}),
+            table.Match(GURL("https://safebrowsing.googleapis.com/v4/x")));
+}
+
+TEST(HostDispatchTableTest, MatchesInInsertionOrder) {
+  HostDispatchTable table;
+  table.Add(3, URLPattern(kHttpOrHttps, "*://*.google.com/*"));
+  table.Add(1, URLPattern(kHttpOrHttps, "*://dl.google.com/*"));
+  table.Add(2, URLPattern(kHttpOrHttps, "*://*/*"));
+  table.Add(4, URLPattern(kHttpOrHttps, "*://www.google.com/*"));
+
+  EXPECT_EQ(std::vector<int>({3, 1, 2}),
+            table.Match(GURL("https://dl.google.com/")));
+  EXPECT_EQ(std::vector<int>({2}), table.Match(GURL("https://brave.com/")));
+}
+
+// Compares the table against trying every pattern in turn over a mixed corpus
+// of redirected and untouched URLs.
+TEST(HostDispatchTableTest, MatchesLinearScanOnMixedCorpus) {
+  const std::vector<std::pair<int, std::string>> patterns = {
+      {0, kGeoLocationsPattern},
+      {1, kCRXDownloadPrefix},
+      {2, kAutofillPrefix},
+      {3, kCRLSetPrefix1},
+      {4, kCRLSetPrefix2},
+      {5, kCRLSetPrefix3},
+      {6, kCRLSetPrefix4},
+      {7, kWidevineGvt1Prefix},
+      {8, "*://*.gvt1.com/*"},
+      {9, kWidevineGoogleDlPrefix},
+      {10, "*://dl.google.com/*"},
+      {11, kChromeCastPrefix},
+      {12, "*://bugs.chromium.org/p/chromium/issues/entry?*"},
+  };
+  const std::vector<GURL> corpus = {
+      GURL("https://www.googleapis.com/geolocation/v1/geolocate?key=a"),
+      GURL("https://clients2.googleusercontent.com/crx/blobs/b/c.crx"),
+      GURL("https://www.gstatic.com/autofill/hash"),
+      GURL("https://dl.google.com/release2/chrome_component/crl-set-1"),
+      GURL("https://r2---sn.gvt1.com/edgedl/release2/chrome_component/a"),
+      GURL("https://redirector.gvt1.com/oimompecagnajdejgnnjijobebaeigek"),
+      GURL("https://dl.google.com/chrome/install.exe"),
+      GURL("https://bugs.chromium.org/p/chromium/issues/entry?comment=a"),
+      GURL("https://brave.com/"),
+      GURL("https://www.example.com/index.html"),
+      GURL("https://cdn.jsdelivr.net/npm/lib.js"),
+      GURL("https://en.wikipedia.org/wiki/Trie"),
+      GURL("https://github.com/brave/brave-browser/issues"),
+      GURL("http://localhost:8080/"),
+      GURL("https://www.google.com/search?q=brave"),
+      GURL("https://fonts.gstatic.com/s/roboto.woff2"),
+  };
+
+  HostDispatchTable table;
+  std::vector<std::pair<int, URLPattern>> linear;
+  for (const auto& pattern : patterns) {
+    table.Add(pattern.first, URLPattern(kHttpOrHttps, pattern.second));
+    linear.emplace_back(pattern.first,
+                        URLPattern(kHttpOrHttps, pattern.second));
+  }
+
+  for (const GURL& url : corpus) {
+    std::vector<int> expected;
+    for (const auto& entry : linear) {
+      if (entry.second.MatchesURL(url))
+        expected.push_back(entry.first);
+    }
+    EXPECT_EQ(expected, table.Match(url)) << url;
+  }
+}
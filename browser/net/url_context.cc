@@ -16,6 +16,7 @@
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 namespace brave {
 
@@ -44,6 +45,15 @@ BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
 BraveRequestInfo::~BraveRequestInfo() = default;
 
+bool BraveRequestInfo::IsThirdParty() const {
+  if (!is_third_party_) {
+    is_third_party_ = !net::registry_controlled_domains::SameDomainOrHost(
+        request_url, tab_origin,
+        net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  }
+  return *is_third_party_;
+}
+
 // static
 void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                                int render_process_id,
@@ -109,6 +119,10 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
       !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
   ctx->allow_referrers = brave_shields::AllowReferrers(map, ctx->tab_origin);
   ctx->upload_data = GetUploadData(request);
+
+  // Compute the public suffix list lookups once here, so that delegate
+  // helpers running on other sequences only read them.
+  ctx->IsThirdParty();
 }
 
 }  // namespace brave
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/optional.h"
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -102,6 +103,15 @@ struct BraveRequestInfo {
 
   std::string upload_data;
 
+  // Public suffix list lookup shared by all the delegate helpers of a
+  // request. It is computed on first use and then memoized, so |request_url|
+  // and |tab_origin| must not change after the first call. |FillCTX| computes
+  // it up front, so helpers running on other sequences only read it.
+  // Returns true if |request_url| is not the same domain or host as
+  // |tab_origin|, with the semantics of
+  // net::registry_controlled_domains::SameDomainOrHost.
+  bool IsThirdParty() const;
+
   static void FillCTX(const network::ResourceRequest& request,
                       int render_process_id,
                       int frame_tree_node_id,
@@ -116,6 +126,8 @@ struct BraveRequestInfo {
 
   GURL* new_url = nullptr;
 
+  mutable base::Optional<bool> is_third_party_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
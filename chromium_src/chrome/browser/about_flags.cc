@@ -18,6 +18,7 @@
 #include "components/prefs/pref_service.h"
 
 using brave_shields::features::kBraveAdblockCosmeticFiltering;
+using brave_shields::features::kBraveAdblockParallelMatching;
 using ntp_background_images::features::kBraveNTPBrandedWallpaper;
 using ntp_background_images::features::kBraveNTPBrandedWallpaperDemo;
 using ntp_background_images::features::kBraveNTPSuperReferralWallpaper;
@@ -64,6 +65,10 @@ using ntp_background_images::features::kBraveNTPSuperReferralWallpaper;
      flag_descriptions::kBraveAdblockCosmeticFilteringName,                \
      flag_descriptions::kBraveAdblockCosmeticFilteringDescription, kOsAll, \
      FEATURE_VALUE_TYPE(kBraveAdblockCosmeticFiltering)},                  \
+    {"brave-adblock-parallel-matching",                                    \
+     flag_descriptions::kBraveAdblockParallelMatchingName,                 \
+     flag_descriptions::kBraveAdblockParallelMatchingDescription, kOsAll,  \
+     FEATURE_VALUE_TYPE(kBraveAdblockParallelMatching)},                   \
     SPEEDREADER_FEATURE_ENTRIES                                            \
     BRAVE_SYNC_FEATURE_ENTRIES                                             \
     {"brave-super-referral",                                               \
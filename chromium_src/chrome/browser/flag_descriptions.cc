@@ -24,6 +24,11 @@ const char kBraveNTPBrandedWallpaperDemoDescription[] =
 const char kBraveAdblockCosmeticFilteringName[] = "Enable cosmetic filtering";
 const char kBraveAdblockCosmeticFilteringDescription[] =
     "Enable support for cosmetic filtering";
+const char kBraveAdblockParallelMatchingName[] =
+    "Enable parallel ad-block matching";
+const char kBraveAdblockParallelMatchingDescription[] =
+    "Match network requests against the ad-block engines on a pool of worker "
+    "threads instead of a single sequence";
 const char kBraveSpeedreaderName[] = "Enable SpeedReader";
 const char kBraveSpeedreaderDescription[] =
     "Enables faster loading of simplified article-style web pages.";
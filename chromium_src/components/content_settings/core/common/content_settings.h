@@ -6,10 +6,14 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+// |generation| is not serialized, so every set of rules received by a
+// renderer gets a new one. Copies share the generation of their source.
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  static uint64_t NextGeneration();               \
+  uint64_t generation = NextGeneration();
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
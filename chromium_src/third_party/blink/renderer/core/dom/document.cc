@@ -6,6 +6,7 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -33,34 +34,6 @@ std::string TopETLDPlusOneForDoc(const Document& doc) {
       blink::network_utils::kIncludePrivateRegistries).Utf8();
 }
 
-const uint64_t zero = 0;
-
-inline uint64_t lfsr_next(uint64_t v) {
-  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
-}
-
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
-}
-
 }  // namespace
 
 namespace brave {
@@ -100,8 +73,7 @@ BraveSessionCache& BraveSessionCache::From(Document& document) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
-    blink::LocalFrame* frame) {
+AudioFarbler BraveSessionCache::GetAudioFarbler(blink::LocalFrame* frame) {
   if (farbling_enabled_ && frame && frame->GetContentSettingsClient()) {
     switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
       case BraveFarblingLevel::OFF: {
@@ -113,15 +85,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarbler::Balanced(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-       return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarbler::Maximum(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarbler();
 }
 
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
@@ -130,96 +102,55 @@ scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
   if (!farbling_enabled_ || !frame || !frame->GetContentSettingsClient()) {
     return image_bitmap;
   }
-  switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
-    case BraveFarblingLevel::OFF:
-      break;
-    case BraveFarblingLevel::BALANCED: {
-      image_bitmap = PerturbBalanced(image_bitmap);
-      break;
-    }
-    case BraveFarblingLevel::MAXIMUM: {
-      image_bitmap = PerturbMax(image_bitmap);
-      break;
-    }
-    default:
-      NOTREACHED();
-  }
-  return image_bitmap;
-}
-
-scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbBalanced(
-    scoped_refptr<blink::StaticBitmapImage> image_bitmap) {
+  const BraveFarblingLevel level =
+      frame->GetContentSettingsClient()->GetBraveFarblingLevel();
+  if (level == BraveFarblingLevel::OFF)
+    return image_bitmap;
   DCHECK(image_bitmap);
   if (image_bitmap->IsNull())
     return image_bitmap;
+
   // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
-  // per pixel
+  // per pixel, and perturb the readback in place
   std::unique_ptr<blink::ImageDataBuffer> data_buffer =
       blink::ImageDataBuffer::Create(image_bitmap);
+  if (!data_buffer)
+    return image_bitmap;
   uint8_t* pixels = const_cast<uint8_t*>(data_buffer->Pixels());
-  // This needs to be type size_t because we pass it to base::StringPiece
-  // later for content hashing. This is safe because the maximum canvas
-  // dimensions are less than SIZE_T_MAX. (Width and height are each
-  // limited to 32,767 pixels.)
+  // This is safe because the maximum canvas dimensions are less than
+  // SIZE_T_MAX. (Width and height are each limited to 32,767 pixels.)
   const size_t pixel_count = data_buffer->Width() * data_buffer->Height();
+  switch (level) {
+    case BraveFarblingLevel::BALANCED:
+      PerturbBalanced(pixels, pixel_count);
+      break;
+    case BraveFarblingLevel::MAXIMUM:
+      PerturbMax(pixels, pixel_count);
+      break;
+    default:
+      NOTREACHED();
+  }
+  // wrap the perturbed pixels to return them to the caller
+  return blink::UnacceleratedStaticBitmapImage::Create(
+      data_buffer->RetainedImage());
+}
+
+void BraveSessionCache::PerturbBalanced(uint8_t* pixels, size_t pixel_count) {
   // choose which channel (R, G, or B) to perturb
-  const uint8_t* first_byte = reinterpret_cast<const uint8_t*>(domain_key_);
-  uint8_t channel = *first_byte % 3;
-  // calculate initial seed to find first pixel to perturb, based on session
-  // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
+  const uint8_t channel = domain_key_[0] % 3;
+  // seed to find the pixels to perturb, based on session key, domain key, and
+  // canvas contents
+  const uint64_t session_plus_domain_key =
       session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(
-      base::StringPiece(reinterpret_cast<const char*>(pixels), pixel_count),
-      canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
-  uint64_t pixel_index;
-  // iterate through 32-byte canvas key and use each bit to determine how to
-  // perturb the current pixel
-  for (int i = 0; i < 32; i++) {
-    uint8_t bit = canvas_key[i];
-    for (int j = 8; j >= 0; j--) {
-      pixel_index = 4 * (v % pixel_count) + channel;
-      pixels[pixel_index] = pixels[pixel_index] ^ (bit & 0x1);
-      bit = bit >> 1;
-      // find next pixel to perturb
-      v = lfsr_next(v);
-    }
-  }
-  // convert back to a StaticBitmapImage to return to the caller
-  scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
-      blink::UnacceleratedStaticBitmapImage::Create(
-          data_buffer->RetainedImage());
-  return perturbed_bitmap;
+  const uint64_t content_hash =
+      HashCanvasPixels(session_plus_domain_key, pixels, 4 * pixel_count);
+  PerturbCanvasBalanced(content_hash, channel, pixels, pixel_count);
 }
 
-scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbMax(
-    scoped_refptr<blink::StaticBitmapImage> image_bitmap) {
-  DCHECK(image_bitmap);
-  if (image_bitmap->IsNull())
-    return image_bitmap;
-  // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
-  // per pixel
-  std::unique_ptr<blink::ImageDataBuffer> data_buffer =
-      blink::ImageDataBuffer::Create(image_bitmap);
-  uint8_t* pixels = const_cast<uint8_t*>(data_buffer->Pixels());
-  const uint64_t count = 4 * data_buffer->Width() * data_buffer->Height();
-  // initial seed based on domain key
-  uint64_t v = *reinterpret_cast<uint64_t*>(domain_key_);
-  // iterate through pixel data and overwrite with next value in PRNG sequence
-  for (uint64_t i = 0; i < count; i++) {
-    pixels[i] = v % 256;
-    v = lfsr_next(v);
-  }
-  // convert back to a StaticBitmapImage to return to the caller
-  scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
-      blink::UnacceleratedStaticBitmapImage::Create(
-          data_buffer->RetainedImage());
-  return perturbed_bitmap;
+void BraveSessionCache::PerturbMax(uint8_t* pixels, size_t pixel_count) {
+  // overwrite the pixel data with a PRNG sequence seeded by the domain key
+  PerturbCanvasMax(*reinterpret_cast<uint64_t*>(domain_key_), pixels,
+                   4 * pixel_count);
 }
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
@@ -10,7 +10,7 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
 
 using blink::Document;
 using blink::GarbageCollected;
@@ -27,8 +27,6 @@ class StaticBitmapImage;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
-
 class CORE_EXPORT BraveSessionCache final
     : public GarbageCollected<BraveSessionCache>,
       public Supplement<Document> {
@@ -42,8 +40,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(Document&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
-      blink::LocalFrame* frame);
+  AudioFarbler GetAudioFarbler(blink::LocalFrame* frame);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::LocalFrame* frame,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
@@ -55,10 +52,8 @@ class CORE_EXPORT BraveSessionCache final
   uint64_t session_key_;
   uint8_t domain_key_[32];
 
-  scoped_refptr<blink::StaticBitmapImage> PerturbBalanced(
-      scoped_refptr<blink::StaticBitmapImage> image_bitmap);
-  scoped_refptr<blink::StaticBitmapImage> PerturbMax(
-      scoped_refptr<blink::StaticBitmapImage> image_bitmap);
+  void PerturbBalanced(uint8_t* pixels, size_t pixel_count);
+  void PerturbMax(uint8_t* pixels, size_t pixel_count);
 };
 }  // namespace brave
 
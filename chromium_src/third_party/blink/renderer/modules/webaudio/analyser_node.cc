@@ -9,10 +9,10 @@
 
 #define BRAVE_ANALYSERHANDLER_CONSTRUCTOR                 \
   ExecutionContext* context = node.GetExecutionContext(); \
-  analyser_.audio_farbling_callback_ =                    \
+  analyser_.audio_farbler_ =                              \
       brave::BraveSessionCache::From(                     \
           *(To<LocalDOMWindow>(context)->document()))     \
-          .GetAudioFarblingCallback(                      \
+          .GetAudioFarbler(                               \
               To<LocalDOMWindow>(context)->document()->GetFrame());
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/analyser_node.cc"
@@ -4,16 +4,16 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB \
-  destination[i] = audio_farbling_callback_.Run(destination[i], i);
+  destination[i] = audio_farbler_.FarbleSample(destination[i], i);
 
 #define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA \
-  scaled_value = audio_farbling_callback_.Run(scaled_value, i);
+  scaled_value = audio_farbler_.FarbleSample(scaled_value, i);
 
 #define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA \
-  destination[i] = audio_farbling_callback_.Run(value, i);
+  destination[i] = audio_farbler_.FarbleSample(value, i);
 
 #define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA \
-  value = audio_farbling_callback_.Run(value, i);
+  value = audio_farbler_.FarbleSample(value, i);
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/realtime_analyser.cc"
 
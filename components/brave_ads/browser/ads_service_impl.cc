@@ -52,6 +52,7 @@
 #if !defined(OS_ANDROID)
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/browser_finder.h"
+#include "chrome/browser/ui/browser_list.h"
 #endif
 #include "chrome/browser/ui/browser_navigator_params.h"
 #include "chrome/browser/first_run/first_run.h"
@@ -500,6 +501,9 @@ GetAutomaticallyDetectedAdsSubdivisionTargetingCode() const {
 
 void AdsServiceImpl::Shutdown() {
   BackgroundHelper::GetInstance()->RemoveObserver(this);
+#if !defined(OS_ANDROID)
+  BrowserList::RemoveObserver(this);
+#endif
 
   for (auto* const url_loader : url_loaders_) {
     delete url_loader;
@@ -668,6 +672,9 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(
   }
 
   BackgroundHelper::GetInstance()->AddObserver(this);
+#if !defined(OS_ANDROID)
+  BrowserList::AddObserver(this);
+#endif
 
   bat_ads_service_->Create(
       bat_ads_client_receiver_.BindNewEndpointAndPassRemote(),
@@ -2074,4 +2081,18 @@ void AdsServiceImpl::OnForeground() {
   bat_ads_->OnForeground();
 }
 
+#if !defined(OS_ANDROID)
+void AdsServiceImpl::OnBrowserRemoved(
+    Browser* browser) {
+  if (!connected() || !BrowserList::GetInstance()->empty()) {
+    return;
+  }
+
+  // Pending state must be saved while the message loop is still running, as
+  // by the time |Shutdown| is called the connection is torn down before the
+  // ads service could reply
+  bat_ads_->FlushState();
+}
+#endif
+
 }  // namespace brave_ads
@@ -37,6 +37,10 @@
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "ui/base/idle/idle.h"
 
+#if !defined(OS_ANDROID)
+#include "chrome/browser/ui/browser_list_observer.h"
+#endif
+
 using brave_rewards::RewardsNotificationService;
 using brave_user_model::UserModelFileService;
 
@@ -64,6 +68,9 @@ class AdsServiceImpl : public AdsService,
                        public history::HistoryServiceObserver,
                        BackgroundHelper::Observer,
                        public brave_user_model::Observer,
+#if !defined(OS_ANDROID)
+                       public BrowserListObserver,
+#endif
                        public base::SupportsWeakPtr<AdsServiceImpl> {
  public:
   // AdsService implementation
@@ -451,6 +458,12 @@ class AdsServiceImpl : public AdsService,
   void OnBackground() override;
   void OnForeground() override;
 
+#if !defined(OS_ANDROID)
+  // BrowserListObserver implementation
+  void OnBrowserRemoved(
+      Browser* browser) override;
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
   Profile* profile_;  // NOT OWNED
@@ -10,6 +10,7 @@
 #include "base/logging.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/metrics/histogram_functions.h"
 
 namespace brave_component_updater {
 
@@ -44,4 +45,40 @@ std::string GetDATFileAsString(const base::FilePath& file_path) {
   return contents;
 }
 
+bool MapDATFile(const base::FilePath& file_path,
+                base::MemoryMappedFile* mapped_file) {
+  if (!mapped_file->Initialize(file_path) || 0 == mapped_file->length()) {
+    LOG(ERROR) << "MapDATFile: "
+               << "the dat file is not found or corrupted "
+               << file_path;
+    return false;
+  }
+  return true;
+}
+
+DATFileLoadMemoryRecorder::DATFileLoadMemoryRecorder(
+    const std::string& component)
+    : component_(component),
+      process_metrics_(base::ProcessMetrics::CreateCurrentProcessMetrics()),
+      initial_usage_(process_metrics_->GetMallocUsage()) {}
+
+DATFileLoadMemoryRecorder::~DATFileLoadMemoryRecorder() {
+  base::UmaHistogramMemoryKB(
+      "Brave.DATFile.HeapGrowthAfterRelease." + component_,
+      GetHeapGrowthKB());
+}
+
+void DATFileLoadMemoryRecorder::OnDeserialized() {
+  base::UmaHistogramMemoryKB(
+      "Brave.DATFile.HeapGrowthAfterDeserialize." + component_,
+      GetHeapGrowthKB());
+}
+
+int DATFileLoadMemoryRecorder::GetHeapGrowthKB() const {
+  const size_t usage = process_metrics_->GetMallocUsage();
+  return usage > initial_usage_
+             ? static_cast<int>((usage - initial_usage_) / 1024)
+             : 0;
+}
+
 }  // namespace brave_component_updater
@@ -6,12 +6,17 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/macros.h"
+#include "base/process/process_metrics.h"
 
 namespace brave_component_updater {
 
@@ -20,27 +25,91 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
+// Maps the DAT file at |file_path| read-only. Returns false if it is missing,
+// empty or can't be mapped.
+bool MapDATFile(const base::FilePath& file_path,
+                base::MemoryMappedFile* mapped_file);
+
+// Records how much the malloc heap of the current process has grown since
+// the DAT file of |component| started loading: once the data is deserialized
+// and, on destruction, once the serialized data is released. Only the heap is
+// measured, so neither value includes the pages of a mapped file.
+//
+// NOTE: The heap is shared by the whole process, so these histograms are not
+// accurate per load when loads overlap, e.g. the default and regional ad-block
+// lists at startup: each sample also counts the growth of the other loads.
+// Compare distributions across versions rather than reading single samples.
+class DATFileLoadMemoryRecorder {
+ public:
+  explicit DATFileLoadMemoryRecorder(const std::string& component);
+  ~DATFileLoadMemoryRecorder();
+
+  void OnDeserialized();
+
+ private:
+  int GetHeapGrowthKB() const;
+
+  const std::string component_;
+  const std::unique_ptr<base::ProcessMetrics> process_metrics_;
+  const size_t initial_usage_;
 
-template<typename T>
-using LoadDATFileDataResult =
-    std::pair<std::unique_ptr<T>, brave_component_updater::DATFileDataBuffer>;
+  DISALLOW_COPY_AND_ASSIGN(DATFileLoadMemoryRecorder);
+};
 
-template<typename T>
-LoadDATFileDataResult<T> LoadDATFileData(
-    const base::FilePath& dat_file_path) {
+template <typename T>
+struct LoadDATFileDataResult {
+  // Null if the file could not be read or deserialized.
+  std::unique_ptr<T> data;
+  // Tells a missing or unreadable file from one which failed to deserialize.
+  bool file_found = false;
+  // Serialized data, only kept by LoadDATFileDataAndBuffer().
   DATFileDataBuffer buffer;
-  GetDATFileData(dat_file_path, &buffer);
-  std::unique_ptr<T> client;
-  client = std::make_unique<T>();
-  if (buffer.empty() ||
-      !client->deserialize(reinterpret_cast<char*>(&buffer.front()),
-          buffer.size()))
-    client.reset();
-
-  return LoadDATFileDataResult<T>(
-      std::move(client), std::move(buffer));
+};
+
+// Deserializes the DAT file at |dat_file_path| straight from a read-only
+// mapping of the file, which is released before returning. Only the
+// deserialized T is left alive, so T must copy whatever it needs out of the
+// data. |component| names the caller in the memory histograms.
+template <typename T>
+LoadDATFileDataResult<T> LoadDATFileData(const base::FilePath& dat_file_path,
+                                         const std::string& component) {
+  DATFileLoadMemoryRecorder memory_recorder(component);
+  LoadDATFileDataResult<T> result;
+  base::MemoryMappedFile mapped_file;
+  if (!MapDATFile(dat_file_path, &mapped_file))
+    return result;
+
+  result.file_found = true;
+  result.data = std::make_unique<T>();
+  if (!result.data->deserialize(
+          reinterpret_cast<char*>(const_cast<uint8_t*>(mapped_file.data())),
+          mapped_file.length()))
+    result.data.reset();
+  memory_recorder.OnDeserialized();
+  return result;
 }
 
+// Same as above, for types which keep pointing into the serialized data after
+// deserialization. The data is read into |buffer|, which the caller must keep
+// alive for as long as the deserialized T.
+template <typename T>
+LoadDATFileDataResult<T> LoadDATFileDataAndBuffer(
+    const base::FilePath& dat_file_path,
+    const std::string& component) {
+  DATFileLoadMemoryRecorder memory_recorder(component);
+  LoadDATFileDataResult<T> result;
+  GetDATFileData(dat_file_path, &result.buffer);
+  if (result.buffer.empty())
+    return result;
+
+  result.file_found = true;
+  result.data = std::make_unique<T>();
+  if (!result.data->deserialize(reinterpret_cast<char*>(&result.buffer.front()),
+                                result.buffer.size()))
+    result.data.reset();
+  memory_recorder.OnDeserialized();
+  return result;
+}
 
 }  // namespace brave_component_updater
 
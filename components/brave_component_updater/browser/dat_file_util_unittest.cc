@@ -0,0 +1,96 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_component_updater {
+
+namespace {
+
+constexpr char kValidData[] = "valid";
+
+// Deserializes only |kValidData|, and keeps a copy of it.
+class TestClient {
+ public:
+  bool deserialize(char* data, size_t size) {
+    data_.assign(data, size);
+    return data_ == kValidData;
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+}  // namespace
+
+class DATFileUtilTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteDATFile(const std::string& contents) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII("test.dat");
+    const int size = static_cast<int>(contents.size());
+    EXPECT_EQ(size, base::WriteFile(path, contents.data(), size));
+    return path;
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(DATFileUtilTest, LoadMissingFile) {
+  const auto result = LoadDATFileData<TestClient>(
+      temp_dir_.GetPath().AppendASCII("missing.dat"), "Test");
+  EXPECT_FALSE(result.file_found);
+  EXPECT_FALSE(result.data);
+}
+
+TEST_F(DATFileUtilTest, LoadEmptyFile) {
+  const auto result = LoadDATFileData<TestClient>(WriteDATFile(""), "Test");
+  EXPECT_FALSE(result.file_found);
+  EXPECT_FALSE(result.data);
+}
+
+TEST_F(DATFileUtilTest, LoadCorruptFile) {
+  const auto result =
+      LoadDATFileData<TestClient>(WriteDATFile("corrupt"), "Test");
+  EXPECT_TRUE(result.file_found);
+  EXPECT_FALSE(result.data);
+}
+
+TEST_F(DATFileUtilTest, LoadValidFile) {
+  const auto result =
+      LoadDATFileData<TestClient>(WriteDATFile(kValidData), "Test");
+  EXPECT_TRUE(result.file_found);
+  ASSERT_TRUE(result.data);
+  EXPECT_EQ(kValidData, result.data->data());
+  // The serialized data is released once deserialized.
+  EXPECT_TRUE(result.buffer.empty());
+}
+
+TEST_F(DATFileUtilTest, LoadValidFileAndBuffer) {
+  const auto result =
+      LoadDATFileDataAndBuffer<TestClient>(WriteDATFile(kValidData), "Test");
+  EXPECT_TRUE(result.file_found);
+  ASSERT_TRUE(result.data);
+  EXPECT_EQ(std::string(kValidData),
+            std::string(result.buffer.begin(), result.buffer.end()));
+}
+
+TEST_F(DATFileUtilTest, LoadCorruptFileAndBuffer) {
+  const auto result =
+      LoadDATFileDataAndBuffer<TestClient>(WriteDATFile("corrupt"), "Test");
+  EXPECT_TRUE(result.file_found);
+  EXPECT_FALSE(result.data);
+}
+
+}  // namespace brave_component_updater
@@ -67,26 +67,27 @@ void ExtensionWhitelistService::OnComponentReady(
   base::PostTaskAndReplyWithResult(
       local_data_files_service()->GetTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(
-          &brave_component_updater::LoadDATFileData<ExtensionWhitelistParser>,
-          dat_file_path),
+      base::BindOnce(&brave_component_updater::LoadDATFileDataAndBuffer<
+                         ExtensionWhitelistParser>,
+                     dat_file_path, "ExtensionWhitelist"),
       base::BindOnce(&ExtensionWhitelistService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
 
 void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (result.second.empty()) {
+  if (!result.file_found) {
     LOG(ERROR) << "Could not obtain extension whitelist data";
     return;
   }
-  if (!result.first.get()) {
+  if (!result.data.get()) {
     LOG(ERROR) << "Failed to deserialize extension whitelist data";
     return;
   }
 
-  extension_whitelist_client_ = std::move(result.first);
-  buffer_ = std::move(result.second);
+  extension_whitelist_client_ = std::move(result.data);
+  // The parser keeps pointing into the serialized data.
+  buffer_ = std::move(result.buffer);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
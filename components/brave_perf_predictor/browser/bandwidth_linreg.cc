@@ -7,8 +7,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
-#include <utility>
 
 #include "base/logging.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
@@ -49,18 +47,14 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
     return 0;
   }
 
-  // Create a new feature vector to include all features
-  std::array<double, feature_count> standardised_features;
-  std::move(numeric_features.begin(), numeric_features.end(),
-            standardised_features.begin());
-  // Just copy the rest of the features as-is
-  std::copy(features.begin() + standardise_feat_count, features.end(),
-            standardised_features.begin() + standardise_feat_count);
-
-  // Calculate the prediction
-  double log_prediction = std::inner_product(
-      standardised_features.begin(), standardised_features.end(),
-      model_coefficients.begin(), model_intercept);
+  // Calculate the prediction, only visiting features with a non-zero
+  // coefficient. Numeric features are standardised, the rest are used as-is.
+  double log_prediction = model_intercept;
+  for (const unsigned int i : model_nonzero_coefficients) {
+    const double feature =
+        i < standardise_feat_count ? numeric_features[i] : features[i];
+    log_prediction += feature * model_coefficients[i];
+  }
   // We know the target is log-scaled but care about the absolute value
   return std::pow(10, log_prediction);
 }
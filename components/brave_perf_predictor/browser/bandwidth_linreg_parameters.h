@@ -288,6 +288,145 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 3333644.900695055
 };
 
+// Position of every standardised feature in |feature_sequence|.
+enum StandardisedFeature : unsigned int {
+  kAdblockRequests,
+  kMetricsFirstMeaningfulPaint,
+  kMetricsObservedDomContentLoaded,
+  kMetricsObservedFirstVisualChange,
+  kMetricsObservedLoad,
+  kResourcesDocumentRequestCount,
+  kResourcesDocumentSize,
+  kResourcesFontRequestCount,
+  kResourcesFontSize,
+  kResourcesImageRequestCount,
+  kResourcesImageSize,
+  kResourcesMediaRequestCount,
+  kResourcesMediaSize,
+  kResourcesOtherRequestCount,
+  kResourcesOtherSize,
+  kResourcesScriptRequestCount,
+  kResourcesScriptSize,
+  kResourcesStylesheetRequestCount,
+  kResourcesStylesheetSize,
+  kResourcesThirdPartyRequestCount,
+  kResourcesThirdPartySize,
+  kResourcesTotalRequestCount,
+  kResourcesTotalSize,
+};
+
+// Third-party features follow the standardised features, in the order of
+// |relevant_entities|.
+constexpr unsigned int third_party_feat_offset = standardise_feat_count;
+
+// Positions of the non-zero entries of |model_coefficients|.
+constexpr std::array<unsigned int, 104> model_nonzero_coefficients = {
+0,
+5,
+6,
+7,
+8,
+10,
+11,
+13,
+14,
+15,
+18,
+19,
+23,
+24,
+26,
+27,
+29,
+30,
+31,
+32,
+34,
+38,
+39,
+41,
+42,
+44,
+50,
+51,
+52,
+54,
+56,
+57,
+58,
+63,
+66,
+67,
+69,
+75,
+79,
+80,
+82,
+83,
+84,
+86,
+87,
+89,
+90,
+93,
+96,
+97,
+98,
+101,
+102,
+106,
+107,
+110,
+112,
+113,
+116,
+118,
+119,
+120,
+122,
+124,
+126,
+128,
+129,
+130,
+131,
+133,
+134,
+135,
+139,
+142,
+144,
+145,
+146,
+148,
+149,
+151,
+155,
+164,
+165,
+166,
+167,
+170,
+174,
+176,
+177,
+178,
+181,
+184,
+185,
+187,
+188,
+193,
+195,
+196,
+198,
+204,
+206,
+207,
+210,
+211
+};
+
 const std::array<std::string, feature_count> feature_sequence{
     "adblockRequests",
     "metrics.firstMeaningfulPaint",
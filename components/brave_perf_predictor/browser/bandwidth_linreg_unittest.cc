@@ -43,6 +43,19 @@ TEST(BraveSavingsPredictorTest, HandlesSpecificVectorExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndicesMatchSequence) {
+  EXPECT_EQ(feature_sequence[kAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kResourcesThirdPartyRequestCount],
+            "resources.third-party.requestCount");
+  EXPECT_EQ(feature_sequence[kResourcesTotalSize], "resources.total.size");
+  for (unsigned int i = 0; i < relevant_entities.size(); i++) {
+    EXPECT_EQ(feature_sequence[third_party_feat_offset + i],
+              "thirdParties." + relevant_entities[i] + ".blocked");
+  }
+  for (const unsigned int i : model_nonzero_coefficients)
+    EXPECT_NE(model_coefficients[i], 0);
+}
+
 TEST(BraveSavingsPredictorTest, HandlesEmptyFeatureset) {
   const base::flat_map<std::string, double> features{};
   const double result = LinregPredictNamed(features);
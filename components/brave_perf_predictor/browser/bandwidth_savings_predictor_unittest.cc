@@ -5,9 +5,11 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
@@ -20,6 +22,19 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+double GetFeature(const std::array<double, feature_count>& features,
+                  const std::string& name) {
+  const auto it =
+      std::find(feature_sequence.begin(), feature_sequence.end(), name);
+  if (it == feature_sequence.end())
+    return 0;
+  return features[it - feature_sequence.begin()];
+}
+
+}  // namespace
+
 class BandwidthSavingsPredictorTest : public ::testing::Test {
  public:
   BandwidthSavingsPredictorTest() {
@@ -39,45 +54,60 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  EXPECT_EQ(GetFeature(predictor_->features_, "adblockRequests"), 1);
+  EXPECT_EQ(GetFeature(predictor_->features_,
+                       "thirdParties.Google Analytics.blocked"),
             1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(GetFeature(predictor_->features_, "adblockRequests"), 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.firstMeaningfulPaint"),
+      0);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.observedDomContentLoaded"),
+      0);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.observedFirstVisualChange"),
+      0);
+  EXPECT_EQ(GetFeature(predictor_->features_, "metrics.observedLoad"), 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.observedDomContentLoaded"),
+      1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(GetFeature(predictor_->features_, "metrics.observedLoad"), 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.firstMeaningfulPaint"),
+      1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "metrics.observedFirstVisualChange"),
+      800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.third-party.requestCount"),
+      0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -86,9 +116,15 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.third-party.requestCount"),
+      0);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.stylesheet.requestCount"),
+      1);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.stylesheet.size"),
+      1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -96,14 +132,65 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.third-party.requestCount"),
+      1);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.stylesheet.requestCount"),
+      1);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.script.requestCount"),
+      1);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.stylesheet.size"),
+      1000);
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.script.size"), 1001);
+
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.total.requestCount"),
+      2);
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.total.size"), 2001);
+}
+
+TEST_F(BandwidthSavingsPredictorTest, FeaturiseManyResources) {
+  const GURL main_frame("https://brave.com/");
+
+  // Replay a page with 500 resources of various types.
+  constexpr network::mojom::RequestDestination kDestinations[] = {
+      network::mojom::RequestDestination::kScript,
+      network::mojom::RequestDestination::kImage,
+      network::mojom::RequestDestination::kStyle,
+      network::mojom::RequestDestination::kFont,
+      network::mojom::RequestDestination::kEmpty};
+  for (int i = 0; i < 500; i++) {
+    const std::string url = i % 2 ? "https://brave.com/resource"
+                                  : "https://google-analytics.com/resource";
+    auto resource =
+        predictors::CreateResourceLoadInfo(url, kDestinations[i % 5]);
+    resource->raw_body_bytes = 100;
+    resource->total_received_bytes = 120;
+    predictor_->OnResourceLoadComplete(main_frame, *resource);
+  }
+  predictor_->OnSubresourceBlocked("https://google-analytics.com/ga.js");
+
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.total.requestCount"),
+            500);
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.total.size"), 50000);
+  EXPECT_EQ(
+      GetFeature(predictor_->features_, "resources.third-party.requestCount"),
+      250);
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.script.requestCount"),
+            100);
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.other.size"), 10000);
+  EXPECT_EQ(GetFeature(predictor_->features_,
+                       "thirdParties.Google Analytics.blocked"),
+            1);
+  EXPECT_EQ(predictor_->transfer_total_size_, 60000);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  predictor_->Reset();
+  EXPECT_EQ(GetFeature(predictor_->features_, "resources.total.requestCount"),
+            0);
+  EXPECT_EQ(predictor_->transfer_total_size_, 0);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -3,6 +3,7 @@ import pandas as pd
 import numpy as np
 import joblib
 import jinja2
+import re
 from sklearn.model_selection import train_test_split
 from sklearn.pipeline import Pipeline
 from sklearn.pipeline import FeatureUnion
@@ -148,6 +149,10 @@ def train_model(print_params=False, reg=REGRESSOR):
 
     return model.get_params()
 
+def _feature_id(feature):
+    # e.g. "resources.third-party.size" -> "kResourcesThirdPartySize"
+    return 'k' + ''.join(part[0].upper() + part[1:] for part in re.split(r'[.\-]', feature))
+
 def export_model():
     # Load trained model and predict on test set
     model = joblib.load(MODEL_PATH)
@@ -176,15 +181,22 @@ def export_model():
         else:
             raise Exception('Unexpected pre_processor transformer: {}'.format(name))
 
+    # The predictor relies on all pass-through features being third parties
+    for feature in transformers['passthrough']['features']:
+        if not feature.startswith('thirdParties.'):
+            raise Exception('Unexpected pass-through feature: {}'.format(feature))
+
     env = jinja2.Environment(loader=jinja2.FileSystemLoader(EXPORT_TEMPLATE_PATH), trim_blocks=True, lstrip_blocks=True)
     data = {
         'transformers': transformers,
         'model': {
             'intercept': model['model'].intercept_,
-            'coefficients': model['model'].coef_
+            'coefficients': model['model'].coef_,
+            'nonzero_coefficients': [ i for (i, coefficient) in enumerate(model['model'].coef_) if coefficient != 0 ]
         },
         'misc': {
-            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ]
+            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ],
+            'feature_ids': [ _feature_id(feature) for feature in transformers['standardise']['features'] ]
         }
     }
     env.get_template(EXPORT_TEMPLATE_NAME).stream(data).dump(EXPORT_OUTPUT_PATH)
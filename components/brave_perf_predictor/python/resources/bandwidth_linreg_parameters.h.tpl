@@ -32,6 +32,22 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 {{transformers.standardise.scale | join(',\n')}}
 };
 
+// Position of every standardised feature in |feature_sequence|.
+enum StandardisedFeature : unsigned int {
+  {% for feature_id in misc.feature_ids %}
+  {{feature_id}},
+  {% endfor %}
+};
+
+// Third-party features follow the standardised features, in the order of
+// |relevant_entities|.
+constexpr unsigned int third_party_feat_offset = standardise_feat_count;
+
+// Positions of the non-zero entries of |model_coefficients|.
+constexpr std::array<unsigned int, {{model.nonzero_coefficients | length}}> model_nonzero_coefficients = {
+{{model.nonzero_coefficients | join(',\n')}}
+};
+
 const std::array<std::string, feature_count> feature_sequence{
     {% for feature in transformers.standardise.features %}
     "{{feature}}",
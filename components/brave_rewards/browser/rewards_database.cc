@@ -18,6 +18,8 @@ namespace brave_rewards {
 
 namespace {
 
+const size_t kMaxCachedStatements = 100;
+
 void HandleBinding(
     sql::Statement* statement,
     const ledger::DBCommandBinding& binding) {
@@ -50,12 +52,22 @@ void HandleBinding(
       statement->BindNull(binding.index);
       return;
     }
+    case ledger::DBValue::Tag::BLOB_VALUE: {
+      const std::vector<uint8_t>& blob = binding.value->get_blob_value();
+      statement->BindBlob(binding.index, blob.data(),
+                          static_cast<int>(blob.size()));
+      return;
+    }
     default: {
       NOTREACHED();
     }
   }
 }
 
+bool IsParametrized(const ledger::DBCommand& command) {
+  return !command.bindings.empty() || !command.binding_rows.empty();
+}
+
 ledger::DBRecordPtr CreateRecord(
     sql::Statement* statement,
     const std::vector<ledger::DBCommand::RecordBindingType>& bindings) {
@@ -190,6 +202,7 @@ void RewardsDatabase::RunTransaction(
 
   if (vacuum_requested) {
     VLOG(8) << "Performing database vacuum";
+    statements_.clear();
     if (!db_.Execute("VACUUM")) {
       // If vacuum was not successful, log an error but do not
       // prevent forward progress.
@@ -270,13 +283,35 @@ ledger::DBCommandResponse::Status RewardsDatabase::Run(
     return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
   }
 
-  sql::Statement statement(db_.GetUniqueStatement(command->command.c_str()));
+  sql::Statement unique_statement;
+  sql::Statement* statement = PrepareStatement(*command, &unique_statement);
 
-  for (auto const& binding : command->bindings) {
-    HandleBinding(&statement, *binding.get());
+  if (command->binding_rows.empty()) {
+    for (auto const& binding : command->bindings) {
+      HandleBinding(statement, *binding.get());
+    }
+
+    return RunStatement(statement);
   }
 
-  if (!statement.Run()) {
+  for (auto const& row : command->binding_rows) {
+    statement->Reset(true);
+    for (auto const& binding : row->bindings) {
+      HandleBinding(statement, *binding.get());
+    }
+
+    const auto status = RunStatement(statement);
+    if (status != ledger::DBCommandResponse::Status::RESPONSE_OK) {
+      return status;
+    }
+  }
+
+  return ledger::DBCommandResponse::Status::RESPONSE_OK;
+}
+
+ledger::DBCommandResponse::Status RewardsDatabase::RunStatement(
+    sql::Statement* statement) {
+  if (!statement->Run()) {
     LOG(ERROR) <<
     "DB Run error: " <<
     db_.GetErrorMessage() <<
@@ -288,6 +323,30 @@ ledger::DBCommandResponse::Status RewardsDatabase::Run(
   return ledger::DBCommandResponse::Status::RESPONSE_OK;
 }
 
+sql::Statement* RewardsDatabase::PrepareStatement(
+    const ledger::DBCommand& command,
+    sql::Statement* unique_statement) {
+  // Commands with inlined values are rarely repeated, so they are not worth
+  // keeping around.
+  if (!IsParametrized(command)) {
+    unique_statement->Assign(db_.GetUniqueStatement(command.command.c_str()));
+    return unique_statement;
+  }
+
+  if (statements_.size() >= kMaxCachedStatements) {
+    statements_.clear();
+  }
+
+  std::unique_ptr<sql::Statement>& statement = statements_[command.command];
+  if (statement) {
+    statement->Reset(true);
+  } else {
+    statement = std::make_unique<sql::Statement>(
+        db_.GetUniqueStatement(command.command.c_str()));
+  }
+  return statement.get();
+}
+
 ledger::DBCommandResponse::Status RewardsDatabase::Read(
     ledger::DBCommand* command,
     ledger::DBCommandResponse* command_response) {
@@ -299,19 +358,19 @@ ledger::DBCommandResponse::Status RewardsDatabase::Read(
     return ledger::DBCommandResponse::Status::RESPONSE_ERROR;
   }
 
-  sql::Statement statement(
-      db_.GetUniqueStatement(command->command.c_str()));
+  sql::Statement unique_statement;
+  sql::Statement* statement = PrepareStatement(*command, &unique_statement);
 
   for (auto const& binding : command->bindings) {
-    HandleBinding(&statement, *binding.get());
+    HandleBinding(statement, *binding.get());
   }
 
   auto result = ledger::DBCommandResult::New();
   result->set_records(std::vector<ledger::DBRecordPtr>());
   command_response->result = std::move(result);
-  while (statement.Step()) {
+  while (statement->Step()) {
     command_response->result->get_records().push_back(
-        CreateRecord(&statement, command->record_bindings));
+        CreateRecord(statement, command->record_bindings));
   }
 
   return ledger::DBCommandResponse::Status::RESPONSE_OK;
@@ -333,6 +392,7 @@ ledger::DBCommandResponse::Status RewardsDatabase::Migrate(
 void RewardsDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  statements_.clear();
   db_.TrimMemory();
 }
 
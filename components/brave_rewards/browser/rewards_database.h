@@ -6,7 +6,9 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_DATABASE_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_DATABASE_H_
 
+#include <map>
 #include <memory>
+#include <string>
 
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
@@ -16,6 +18,7 @@
 #include "sql/database.h"
 #include "sql/init_status.h"
 #include "sql/meta_table.h"
+#include "sql/statement.h"
 
 namespace brave_rewards {
 
@@ -39,6 +42,15 @@ class RewardsDatabase {
 
   ledger::DBCommandResponse::Status Run(ledger::DBCommand* command);
 
+  ledger::DBCommandResponse::Status RunStatement(sql::Statement* statement);
+
+  // Returns the statement for |command|. Parametrized commands reuse a
+  // statement prepared by an earlier transaction, other commands are
+  // prepared into |unique_statement|.
+  sql::Statement* PrepareStatement(
+      const ledger::DBCommand& command,
+      sql::Statement* unique_statement);
+
   ledger::DBCommandResponse::Status Read(
       ledger::DBCommand* command,
       ledger::DBCommandResponse* command_response);
@@ -54,6 +66,9 @@ class RewardsDatabase {
   sql::Database db_;
   sql::MetaTable meta_table_;
   bool initialized_;
+  // Prepared statements keyed by their SQL text. Declared after |db_| so
+  // that they are released first.
+  std::map<std::string, std::unique_ptr<sql::Statement>> statements_;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
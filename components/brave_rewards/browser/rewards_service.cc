@@ -58,6 +58,7 @@ void RewardsService::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   registry->RegisterBooleanPref(prefs::kBraveRewardsEnabled, false);
   registry->RegisterDictionaryPref(prefs::kRewardsExternalWallets);
   registry->RegisterUint64Pref(prefs::kStateServerPublisherListStamp, 0ull);
+  registry->RegisterBooleanPref(prefs::kStatePublisherPrefixListFile, false);
   registry->RegisterStringPref(prefs::kStateUpholdAnonAddress, "");
   registry->RegisterStringPref(prefs::kRewardsBadgeText, "1");
 #if defined(OS_ANDROID)
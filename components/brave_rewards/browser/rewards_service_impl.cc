@@ -212,6 +212,15 @@ std::string LoadOnFileTaskRunner(const base::FilePath& path) {
   return data;
 }
 
+std::vector<uint8_t> LoadBinaryOnFileTaskRunner(const base::FilePath& path) {
+  std::string data;
+  if (!base::ReadFileToString(path, &data)) {
+    return {};
+  }
+
+  return std::vector<uint8_t>(data.begin(), data.end());
+}
+
 bool ResetOnFileTaskRunner(const base::FilePath& path) {
   return base::DeleteFile(path, false);
 }
@@ -1652,6 +1661,46 @@ void RewardsServiceImpl::ResetState(
                      AsWeakPtr(), std::move(callback)));
 }
 
+void RewardsServiceImpl::SaveBinaryState(
+    const std::string& name,
+    const std::vector<uint8_t>& value,
+    ledger::ResultCallback callback) {
+  base::ImportantFileWriter writer(
+      rewards_base_path_.AppendASCII(name), file_task_runner_);
+
+  writer.RegisterOnNextWriteCallbacks(
+      base::Closure(),
+      base::Bind(&PostWriteCallback,
+                 base::Bind(&RewardsServiceImpl::OnSavedState,
+                            AsWeakPtr(),
+                            std::move(callback)),
+                 base::SequencedTaskRunnerHandle::Get()));
+
+  writer.WriteNow(std::make_unique<std::string>(value.begin(), value.end()));
+}
+
+void RewardsServiceImpl::LoadBinaryState(
+    const std::string& name,
+    ledger::OnLoadBinaryStateCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&LoadBinaryOnFileTaskRunner,
+                     rewards_base_path_.AppendASCII(name)),
+      base::BindOnce(&RewardsServiceImpl::OnLoadedBinaryState,
+                     AsWeakPtr(), std::move(callback)));
+}
+
+void RewardsServiceImpl::OnLoadedBinaryState(
+    ledger::OnLoadBinaryStateCallback callback,
+    const std::vector<uint8_t>& value) {
+  if (!Connected()) {
+    return;
+  }
+  callback(value.empty() ? ledger::Result::LEDGER_ERROR
+                         : ledger::Result::LEDGER_OK,
+           value);
+}
+
 void RewardsServiceImpl::OnSavedState(
   ledger::ResultCallback callback, bool success) {
   if (!Connected()) {
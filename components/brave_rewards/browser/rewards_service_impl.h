@@ -364,6 +364,8 @@ class RewardsServiceImpl : public RewardsService,
                                  ledger::PublisherInfoList list);
   void OnTimer(uint32_t timer_id);
   void OnSavedState(ledger::ResultCallback callback, bool success);
+  void OnLoadedBinaryState(ledger::OnLoadBinaryStateCallback callback,
+                           const std::vector<uint8_t>& value);
   void OnLoadedState(ledger::OnLoadCallback callback,
                      const std::string& value);
   void OnResetState(ledger::ResultCallback callback,
@@ -583,6 +585,11 @@ class RewardsServiceImpl : public RewardsService,
                  ledger::OnLoadCallback callback) override;
   void ResetState(const std::string& name,
                   ledger::ResultCallback callback) override;
+  void SaveBinaryState(const std::string& name,
+                       const std::vector<uint8_t>& value,
+                       ledger::ResultCallback callback) override;
+  void LoadBinaryState(const std::string& name,
+                       ledger::OnLoadBinaryStateCallback callback) override;
   void SetBooleanState(const std::string& name, bool value) override;
   bool GetBooleanState(const std::string& name) const override;
   void SetIntegerState(const std::string& name, int value) override;
@@ -22,7 +22,8 @@ const std::vector<std::string> kOnlyAnonWalletCountries = {
 };
 
 #if defined(OS_ANDROID)
-  const std::map<std::string, bool> kBoolOptions = {};
+  const std::map<std::string, bool> kBoolOptions = {
+      {ledger::kOptionPublisherListInMemory, false}};
 
   const std::map<std::string, int> kIntegerOptions = {};
 
@@ -36,7 +37,8 @@ const std::vector<std::string> kOnlyAnonWalletCountries = {
       {ledger::kOptionPublisherListRefreshInterval,
        7* base::Time::kHoursPerDay * base::Time::kSecondsPerHour}};
 #else
-  const std::map<std::string, bool> kBoolOptions = {};
+  const std::map<std::string, bool> kBoolOptions = {
+      {ledger::kOptionPublisherListInMemory, true}};
 
   const std::map<std::string, int> kIntegerOptions = {};
 
@@ -26,6 +26,8 @@ const char kRewardsNotificationStartupDelay[] =
 const char kRewardsExternalWallets[] = "brave.rewards.external_wallets";
 const char kStateServerPublisherListStamp[] =
     "brave.rewards.publisher_prefix_list_stamp";
+const char kStatePublisherPrefixListFile[] =
+    "brave.rewards.publisher_prefix_list_file";
 const char kStateUpholdAnonAddress[] =
     "brave.rewards.uphold_anon_address";
 const char kRewardsBadgeText[] = "brave.rewards.badge_text";
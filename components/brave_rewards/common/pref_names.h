@@ -24,6 +24,7 @@ extern const char kRewardsBadgeText[];
 
 // Defined in native-ledger
 extern const char kStateServerPublisherListStamp[];
+extern const char kStatePublisherPrefixListFile[];
 extern const char kStateUpholdAnonAddress[];  // DEPRECATED
 extern const char kStatePromotionLastFetchStamp[];
 extern const char kStatePromotionCorruptedMigrated[];
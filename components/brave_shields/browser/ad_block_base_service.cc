@@ -20,87 +20,15 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
 using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
-
-namespace {
-
-std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
-  std::string filter_option = "";
-  switch (resource_type) {
-    // top level page
-    case blink::mojom::ResourceType::kMainFrame:
-      filter_option = "main_frame";
-      break;
-    // frame or iframe
-    case blink::mojom::ResourceType::kSubFrame:
-      filter_option = "sub_frame";
-      break;
-    // a CSS stylesheet
-    case blink::mojom::ResourceType::kStylesheet:
-      filter_option = "stylesheet";
-      break;
-    // an external script
-    case blink::mojom::ResourceType::kScript:
-      filter_option = "script";
-      break;
-    // an image (jpg/gif/png/etc)
-    case blink::mojom::ResourceType::kFavicon:
-    case blink::mojom::ResourceType::kImage:
-      filter_option = "image";
-      break;
-    // a font
-    case blink::mojom::ResourceType::kFontResource:
-      filter_option = "font";
-      break;
-    // an "other" subresource.
-    case blink::mojom::ResourceType::kSubResource:
-      filter_option = "other";
-      break;
-    // an object (or embed) tag for a plugin.
-    case blink::mojom::ResourceType::kObject:
-      filter_option = "object";
-      break;
-    // a media resource.
-    case blink::mojom::ResourceType::kMedia:
-      filter_option = "media";
-      break;
-    // a XMLHttpRequest
-    case blink::mojom::ResourceType::kXhr:
-      filter_option = "xhr";
-      break;
-    // a ping request for <a ping>/sendBeacon.
-    case blink::mojom::ResourceType::kPing:
-      filter_option = "ping";
-      break;
-    // the main resource of a dedicated worker.
-    case blink::mojom::ResourceType::kWorker:
-    // the main resource of a shared worker.
-    case blink::mojom::ResourceType::kSharedWorker:
-    // an explicitly requested prefetch
-    case blink::mojom::ResourceType::kPrefetch:
-    // the main resource of a service worker.
-    case blink::mojom::ResourceType::kServiceWorker:
-    // a report of Content Security Policy violations.
-    case blink::mojom::ResourceType::kCspReport:
-    // a resource that a plugin requested.
-    case blink::mojom::ResourceType::kPluginResource:
-    default:
-      break;
-  }
-  return filter_option;
-}
-
-}  // namespace
 
 namespace brave_shields {
 
@@ -120,40 +48,49 @@ bool AdBlockBaseService::ShouldStartRequest(
     bool* did_match_exception,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            did_match_exception, cancel_request_explicitly,
+                            mock_data_url);
+}
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  bool explicit_cancel;
-  bool saved_from_exception;
-  if (ad_block_client_->matches(
-          url.spec(), url.host(), tab_host, is_third_party,
-          ResourceTypeToString(resource_type), &explicit_cancel,
-          &saved_from_exception, mock_data_url)) {
-    if (cancel_request_explicitly) {
-      *cancel_request_explicitly = explicit_cancel;
-    }
-    // We'd only possibly match an exception filter if we're returning true.
-    if (did_match_exception) {
-      *did_match_exception = false;
+bool AdBlockBaseService::ShouldStartRequest(const AdBlockRequest& request,
+                                            bool* did_match_exception,
+                                            bool* cancel_request_explicitly,
+                                            std::string* mock_data_url) {
+  // Matching only reads the engine, so it may run on any thread concurrently
+  // with other matches.
+  AdBlockDecision decision;
+  if (!decision_cache_.Get(request.cache_key, &decision)) {
+    AdBlockEngineLock::AutoReadLock lock(&engine_lock_);
+    // Read under the lock, writers bump the generation while holding it.
+    const uint64_t generation = decision_cache_.generation();
+    bool explicit_cancel;
+    bool saved_from_exception;
+    if (ad_block_client_->matches(
+            request.url_spec, request.host, request.tab_host,
+            request.is_third_party, request.resource_type, &explicit_cancel,
+            &saved_from_exception, &decision.mock_data_url)) {
+      decision.should_start = false;
+      decision.cancel_request_explicitly = explicit_cancel;
+      // We'd only possibly match an exception filter if we're returning true.
+      decision.did_match_exception = false;
+    } else {
+      decision.did_match_exception = saved_from_exception;
     }
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
-    return false;
+    decision_cache_.Put(request.cache_key, generation, decision);
   }
 
+  if (!decision.mock_data_url.empty() && mock_data_url) {
+    *mock_data_url = decision.mock_data_url;
+  }
+  if (!decision.should_start && cancel_request_explicitly) {
+    *cancel_request_explicitly = decision.cancel_request_explicitly;
+  }
   if (did_match_exception) {
-    *did_match_exception = saved_from_exception;
+    *did_match_exception = decision.did_match_exception;
   }
 
-  return true;
+  return decision.should_start;
 }
 
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
@@ -164,6 +101,8 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  AdBlockEngineLock::AutoWriteLock lock(&engine_lock_);
+  decision_cache_.Invalidate();
   if (enabled) {
     ad_block_client_->addTag(tag);
     tags_.push_back(tag);
@@ -185,6 +124,8 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
+  AdBlockEngineLock::AutoWriteLock lock(&engine_lock_);
+  decision_cache_.Invalidate();
   ad_block_client_->addResources(resources);
   resources_ = resources;
 }
@@ -195,6 +136,7 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
 
 base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
+  AdBlockEngineLock::AutoReadLock lock(&engine_lock_);
   return base::JSONReader::Read(
           this->ad_block_client_->urlCosmeticResources(url));
 }
@@ -203,51 +145,68 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
+  AdBlockEngineLock::AutoReadLock lock(&engine_lock_);
   return base::JSONReader::Read(
           this->ad_block_client_->hiddenClassIdSelectors(classes,
                                                          ids,
                                                          exceptions));
 }
 
-void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
+void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path,
+                                        const std::string& component) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+                     dat_file_path, component),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
 
 void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
+  if (!result.file_found) {
     LOG(ERROR) << "Could not obtain ad block data";
     return;
   }
-  if (!result.first.get()) {
+  if (!result.data.get()) {
     LOG(ERROR) << "Failed to deserialize ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
                                 base::Unretained(this),
-                                std::move(result.first)));
+                                std::move(result.data)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+  // The new engine is fully set up before it is published, so readers never
+  // observe it half configured.
+  AddKnownTagsToAdBlockInstance(ad_block_client.get());
+  AddKnownResourcesToAdBlockInstance(ad_block_client.get());
+  SwapAdBlockClient(std::move(ad_block_client));
+}
+
+void AdBlockBaseService::SwapAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  {
+    AdBlockEngineLock::AutoWriteLock lock(&engine_lock_);
+    decision_cache_.Invalidate();
+    ad_block_client_.swap(ad_block_client);
+  }
+  // |ad_block_client| now holds the previous engine, which is destroyed
+  // outside of the lock.
 }
 
-void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
+void AdBlockBaseService::AddKnownTagsToAdBlockInstance(
+    adblock::Engine* ad_block_client) {
   std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+                [&](const std::string tag) { ad_block_client->addTag(tag); });
 }
 
-void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+void AdBlockBaseService::AddKnownResourcesToAdBlockInstance(
+    adblock::Engine* ad_block_client) {
+  ad_block_client->addResources(resources_);
 }
 
 bool AdBlockBaseService::Init() {
@@ -259,12 +218,13 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
+  auto ad_block_client = std::make_unique<adblock::Engine>(rules);
+  AddKnownTagsToAdBlockInstance(ad_block_client.get());
   if (!resources.empty()) {
     resources_ = resources;
   }
-  AddKnownResourcesToAdBlockInstance();
+  AddKnownResourcesToAdBlockInstance(ad_block_client.get());
+  SwapAdBlockClient(std::move(ad_block_client));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,8 @@
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_lock.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
 class AdBlockServiceTest;
@@ -30,6 +32,8 @@ class Engine;
 
 namespace brave_shields {
 
+struct AdBlockRequest;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
@@ -46,10 +50,21 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url) override;
+  // Same as above, for a request prepared once and shared across engines.
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  const AdBlockDecisionCache& decision_cache() const {
+    return decision_cache_;
+  }
+  // Changes whenever the engine, its tags or its resources change.
+  uint64_t engine_generation() const { return decision_cache_.generation(); }
+
   base::Optional<base::Value> UrlCosmeticResources(
           const std::string& url);
   base::Optional<base::Value> HiddenClassIdSelectors(
@@ -61,12 +76,14 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   friend class ::AdBlockServiceTest;
   bool Init() override;
 
-  void GetDATFileData(const base::FilePath& dat_file_path);
-  void AddKnownTagsToAdBlockInstance();
-  void AddKnownResourcesToAdBlockInstance();
+  // |component| names the list in the DAT file memory histograms.
+  void GetDATFileData(const base::FilePath& dat_file_path,
+                      const std::string& component);
+  void AddKnownTagsToAdBlockInstance(adblock::Engine* ad_block_client);
+  void AddKnownResourcesToAdBlockInstance(adblock::Engine* ad_block_client);
   void ResetForTest(const std::string& rules, const std::string& resources);
-
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Publishes |ad_block_client| in place of the current engine.
+  void SwapAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client);
 
  private:
   void UpdateAdBlockClient(
@@ -74,6 +91,12 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void OnGetDATFileData(GetDATFileDataResult result);
   void OnPreferenceChanges(const std::string& pref_name);
 
+  // Guards |ad_block_client_|. Matches take it for reading from any thread,
+  // engine swaps and tag or resource changes take it for writing.
+  AdBlockEngineLock engine_lock_;
+  std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Invalidated whenever the engine changes.
+  AdBlockDecisionCache decision_cache_;
   std::vector<std::string> tags_;
   std::string resources_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
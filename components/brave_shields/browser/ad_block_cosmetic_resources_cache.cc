@@ -0,0 +1,57 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
+
+#include <utility>
+
+namespace brave_shields {
+
+bool CosmeticResourcesVersion::operator==(
+    const CosmeticResourcesVersion& other) const {
+  return default_generation == other.default_generation &&
+         regional_lists_generation == other.regional_lists_generation &&
+         regional_engines_generation == other.regional_engines_generation &&
+         custom_generation == other.custom_generation;
+}
+
+bool CosmeticResourcesVersion::operator!=(
+    const CosmeticResourcesVersion& other) const {
+  return !(*this == other);
+}
+
+constexpr size_t AdBlockCosmeticResourcesCache::kDefaultMaxSize;
+
+AdBlockCosmeticResourcesCache::AdBlockCosmeticResourcesCache(size_t max_size)
+    : entries_(max_size) {}
+
+AdBlockCosmeticResourcesCache::~AdBlockCosmeticResourcesCache() = default;
+
+bool AdBlockCosmeticResourcesCache::Get(
+    const std::string& host,
+    const CosmeticResourcesVersion& version,
+    base::Value* resources) {
+  base::AutoLock lock(lock_);
+  auto it = entries_.Get(host);
+  if (it != entries_.end()) {
+    if (it->second.version == version) {
+      *resources = it->second.resources.Clone();
+      return true;
+    }
+    // Computed against engines that have since changed.
+    entries_.Erase(it);
+  }
+  return false;
+}
+
+void AdBlockCosmeticResourcesCache::Put(
+    const std::string& host,
+    const CosmeticResourcesVersion& version,
+    const base::Value& resources) {
+  base::AutoLock lock(lock_);
+  entries_.Put(host, Entry{version, resources.Clone()});
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,68 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+// Identifies the state of every engine that contributes cosmetic resources.
+// Any engine, tag, resource or filter list change yields a different version.
+struct CosmeticResourcesVersion {
+  uint64_t default_generation = 0;
+  uint64_t regional_lists_generation = 0;
+  uint64_t regional_engines_generation = 0;
+  uint64_t custom_generation = 0;
+
+  bool operator==(const CosmeticResourcesVersion& other) const;
+  bool operator!=(const CosmeticResourcesVersion& other) const;
+};
+
+// A bounded LRU cache of the cosmetic resources merged from all engines,
+// keyed by hostname. The engines only look at the hostname of the page, so
+// every page of a site shares one entry.
+//
+// Entries are tagged with the version they were computed for, and only served
+// for that same version. Callers read the version before querying the engines,
+// so resources computed while an engine was being replaced are never served.
+class AdBlockCosmeticResourcesCache {
+ public:
+  explicit AdBlockCosmeticResourcesCache(size_t max_size = kDefaultMaxSize);
+  ~AdBlockCosmeticResourcesCache();
+
+  bool Get(const std::string& host,
+           const CosmeticResourcesVersion& version,
+           base::Value* resources);
+  void Put(const std::string& host,
+           const CosmeticResourcesVersion& version,
+           const base::Value& resources);
+
+ private:
+  static constexpr size_t kDefaultMaxSize = 64;
+
+  struct Entry {
+    CosmeticResourcesVersion version;
+    base::Value resources;
+  };
+
+  base::Lock lock_;
+  base::HashingMRUCache<std::string, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockCosmeticResourcesCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
@@ -0,0 +1,83 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
+
+#include <string>
+#include <utility>
+
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::AdBlockCosmeticResourcesCache;
+using brave_shields::CosmeticResourcesVersion;
+
+namespace {
+
+base::Value BuildResources(const std::string& selector) {
+  base::Value resources(base::Value::Type::DICTIONARY);
+  base::Value hide_selectors(base::Value::Type::LIST);
+  hide_selectors.Append(selector);
+  resources.SetKey("hide_selectors", std::move(hide_selectors));
+  resources.SetKey("generichide", base::Value(false));
+  return resources;
+}
+
+}  // namespace
+
+TEST(AdBlockCosmeticResourcesCacheTest, GetAndPut) {
+  AdBlockCosmeticResourcesCache cache;
+  CosmeticResourcesVersion version;
+  base::Value resources;
+  EXPECT_FALSE(cache.Get("brave.com", version, &resources));
+
+  cache.Put("brave.com", version, BuildResources(".ad"));
+
+  ASSERT_TRUE(cache.Get("brave.com", version, &resources));
+  EXPECT_EQ(BuildResources(".ad"), resources);
+  EXPECT_FALSE(cache.Get("example.com", version, &resources));
+}
+
+TEST(AdBlockCosmeticResourcesCacheTest, ChangedVersionIsAMiss) {
+  AdBlockCosmeticResourcesCache cache;
+  CosmeticResourcesVersion version;
+  cache.Put("brave.com", version, BuildResources(".ad"));
+
+  base::Value resources;
+  CosmeticResourcesVersion regional_list_enabled = version;
+  regional_list_enabled.regional_lists_generation++;
+  EXPECT_FALSE(cache.Get("brave.com", regional_list_enabled, &resources));
+
+  // The stale entry was dropped.
+  EXPECT_FALSE(cache.Get("brave.com", version, &resources));
+}
+
+TEST(AdBlockCosmeticResourcesCacheTest, ReturnsCopies) {
+  AdBlockCosmeticResourcesCache cache;
+  CosmeticResourcesVersion version;
+  cache.Put("brave.com", version, BuildResources(".ad"));
+
+  base::Value resources;
+  ASSERT_TRUE(cache.Get("brave.com", version, &resources));
+  resources.FindKey("hide_selectors")->Append(".banner");
+
+  ASSERT_TRUE(cache.Get("brave.com", version, &resources));
+  EXPECT_EQ(BuildResources(".ad"), resources);
+}
+
+TEST(AdBlockCosmeticResourcesCacheTest, Bounded) {
+  AdBlockCosmeticResourcesCache cache(8);
+  CosmeticResourcesVersion version;
+  for (int i = 0; i < 100; ++i)
+    cache.Put(std::to_string(i) + ".com", version, BuildResources(".ad"));
+
+  size_t hits = 0;
+  base::Value resources;
+  for (int i = 0; i < 100; ++i) {
+    if (cache.Get(std::to_string(i) + ".com", version, &resources))
+      hits++;
+  }
+  EXPECT_EQ(8u, hits);
+}
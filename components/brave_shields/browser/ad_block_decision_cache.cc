@@ -0,0 +1,68 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace brave_shields {
+
+constexpr size_t AdBlockDecisionCache::kDefaultMaxSize;
+constexpr size_t AdBlockDecisionCache::kShardCount;
+
+AdBlockDecisionCache::Shard::Shard(size_t max_size) : entries(max_size) {}
+
+AdBlockDecisionCache::Shard::~Shard() = default;
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_size) {
+  const size_t shard_size =
+      std::max<size_t>(1, (max_size + kShardCount - 1) / kShardCount);
+  for (auto& shard : shards_)
+    shard = std::make_unique<Shard>(shard_size);
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+AdBlockDecisionCache::Shard* AdBlockDecisionCache::GetShard(
+    const std::string& key) {
+  return shards_[std::hash<std::string>()(key) % kShardCount].get();
+}
+
+bool AdBlockDecisionCache::Get(const std::string& key,
+                               AdBlockDecision* decision) {
+  Shard* shard = GetShard(key);
+  {
+    base::AutoLock lock(shard->lock);
+    auto it = shard->entries.Get(key);
+    if (it != shard->entries.end()) {
+      if (it->second.generation == generation_.load()) {
+        *decision = it->second.decision;
+        hit_count_++;
+        return true;
+      }
+      // Computed against an engine that has since been replaced.
+      shard->entries.Erase(it);
+    }
+  }
+  miss_count_++;
+  return false;
+}
+
+void AdBlockDecisionCache::Put(const std::string& key,
+                               uint64_t generation,
+                               const AdBlockDecision& decision) {
+  if (generation != generation_.load())
+    return;
+  Shard* shard = GetShard(key);
+  base::AutoLock lock(shard->lock);
+  shard->entries.Put(key, Entry{generation, decision});
+}
+
+void AdBlockDecisionCache::Invalidate() {
+  generation_++;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,83 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// The outcome of matching one request against one engine.
+struct AdBlockDecision {
+  bool should_start = true;
+  bool did_match_exception = false;
+  bool cancel_request_explicitly = false;
+  std::string mock_data_url;
+};
+
+// A bounded LRU cache of engine decisions, keyed by AdBlockRequest::cache_key.
+// Entries are spread over independently locked shards so that lookups from
+// concurrent matches rarely contend.
+//
+// Every entry is tagged with the generation it was computed for. Invalidate()
+// bumps the generation, which atomically turns every existing entry into a
+// miss; callers read generation() before matching and pass it to Put() so
+// that a decision computed against an engine that was replaced in the
+// meantime is never served.
+class AdBlockDecisionCache {
+ public:
+  explicit AdBlockDecisionCache(size_t max_size = kDefaultMaxSize);
+  ~AdBlockDecisionCache();
+
+  bool Get(const std::string& key, AdBlockDecision* decision);
+  void Put(const std::string& key,
+           uint64_t generation,
+           const AdBlockDecision& decision);
+  void Invalidate();
+
+  uint64_t generation() const { return generation_.load(); }
+  uint64_t hit_count() const { return hit_count_.load(); }
+  uint64_t miss_count() const { return miss_count_.load(); }
+
+ private:
+  static constexpr size_t kDefaultMaxSize = 1024;
+  static constexpr size_t kShardCount = 8;
+
+  struct Entry {
+    uint64_t generation;
+    AdBlockDecision decision;
+  };
+
+  struct Shard {
+    explicit Shard(size_t max_size);
+    ~Shard();
+
+    base::Lock lock;
+    base::HashingMRUCache<std::string, Entry> entries;
+  };
+
+  Shard* GetShard(const std::string& key);
+
+  std::unique_ptr<Shard> shards_[kShardCount];
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
@@ -0,0 +1,67 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::AdBlockDecision;
+using brave_shields::AdBlockDecisionCache;
+
+TEST(AdBlockDecisionCacheTest, GetAndPut) {
+  AdBlockDecisionCache cache;
+  AdBlockDecision decision;
+  EXPECT_FALSE(cache.Get("key", &decision));
+
+  AdBlockDecision blocked;
+  blocked.should_start = false;
+  blocked.cancel_request_explicitly = true;
+  blocked.mock_data_url = "data:text/plain,";
+  cache.Put("key", cache.generation(), blocked);
+
+  ASSERT_TRUE(cache.Get("key", &decision));
+  EXPECT_FALSE(decision.should_start);
+  EXPECT_FALSE(decision.did_match_exception);
+  EXPECT_TRUE(decision.cancel_request_explicitly);
+  EXPECT_EQ("data:text/plain,", decision.mock_data_url);
+
+  EXPECT_EQ(1u, cache.hit_count());
+  EXPECT_EQ(1u, cache.miss_count());
+}
+
+TEST(AdBlockDecisionCacheTest, InvalidateDropsEntries) {
+  AdBlockDecisionCache cache;
+  cache.Put("key", cache.generation(), AdBlockDecision());
+  cache.Invalidate();
+
+  AdBlockDecision decision;
+  EXPECT_FALSE(cache.Get("key", &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, StaleGenerationIsNotStored) {
+  AdBlockDecisionCache cache;
+  const uint64_t generation = cache.generation();
+  // The engine changed while the decision was being computed.
+  cache.Invalidate();
+  cache.Put("key", generation, AdBlockDecision());
+
+  AdBlockDecision decision;
+  EXPECT_FALSE(cache.Get("key", &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, Bounded) {
+  AdBlockDecisionCache cache(8);
+  for (int i = 0; i < 1000; ++i)
+    cache.Put(std::to_string(i), cache.generation(), AdBlockDecision());
+
+  size_t hits = 0;
+  AdBlockDecision decision;
+  for (int i = 0; i < 1000; ++i) {
+    if (cache.Get(std::to_string(i), &decision))
+      hits++;
+  }
+  EXPECT_LE(hits, 8u);
+  EXPECT_GT(hits, 0u);
+}
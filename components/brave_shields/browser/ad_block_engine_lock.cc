@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_lock.h"
+
+#include <functional>
+
+#include "base/threading/platform_thread.h"
+
+namespace brave_shields {
+
+constexpr size_t AdBlockEngineLock::kShardCount;
+
+AdBlockEngineLock::AdBlockEngineLock() = default;
+
+AdBlockEngineLock::~AdBlockEngineLock() = default;
+
+base::Lock* AdBlockEngineLock::GetShardForCurrentThread() {
+  const size_t hash =
+      std::hash<base::PlatformThreadId>()(base::PlatformThread::CurrentId());
+  return &shards_[hash % kShardCount];
+}
+
+AdBlockEngineLock::AutoReadLock::AutoReadLock(AdBlockEngineLock* lock)
+    : shard_(lock->GetShardForCurrentThread()) {
+  shard_->Acquire();
+}
+
+AdBlockEngineLock::AutoReadLock::~AutoReadLock() {
+  shard_->Release();
+}
+
+AdBlockEngineLock::AutoWriteLock::AutoWriteLock(AdBlockEngineLock* lock)
+    : lock_(lock) {
+  // Always acquire in the same order so that concurrent writers can't
+  // deadlock.
+  for (auto& shard : lock_->shards_)
+    shard.Acquire();
+}
+
+AdBlockEngineLock::AutoWriteLock::~AutoWriteLock() {
+  for (size_t i = kShardCount; i > 0; --i)
+    lock_->shards_[i - 1].Release();
+}
+
+}  // namespace brave_shields
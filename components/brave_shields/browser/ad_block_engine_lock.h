@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_LOCK_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_LOCK_H_
+
+#include <stddef.h>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// A readers-writer lock made of one base::Lock per shard. Any number of
+// readers share the engine: each only takes the shard picked by its thread
+// id, so matches running on different pool threads do not contend. A writer
+// takes every shard, which excludes all readers and other writers, and is
+// only needed for engine swaps, tag and resource changes.
+//
+// Writers should hold the lock as briefly as possible. To replace an engine,
+// build the new one without the lock, swap the pointers under an
+// AutoWriteLock, and destroy the previous engine after releasing it.
+class AdBlockEngineLock {
+ public:
+  AdBlockEngineLock();
+  ~AdBlockEngineLock();
+
+  class AutoReadLock {
+   public:
+    explicit AutoReadLock(AdBlockEngineLock* lock);
+    ~AutoReadLock();
+
+   private:
+    base::Lock* shard_;
+    DISALLOW_COPY_AND_ASSIGN(AutoReadLock);
+  };
+
+  class AutoWriteLock {
+   public:
+    explicit AutoWriteLock(AdBlockEngineLock* lock);
+    ~AutoWriteLock();
+
+   private:
+    AdBlockEngineLock* lock_;
+    DISALLOW_COPY_AND_ASSIGN(AutoWriteLock);
+  };
+
+ private:
+  static constexpr size_t kShardCount = 8;
+
+  base::Lock* GetShardForCurrentThread();
+
+  base::Lock shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngineLock);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_LOCK_H_
@@ -70,7 +70,8 @@ void AdBlockRegionalService::OnComponentReady(
   base::FilePath dat_file_path =
       install_dir.AppendASCII(std::string("rs-") + uuid_)
           .AddExtension(FILE_PATH_LITERAL(".dat"));
-  GetDATFileData(dat_file_path);
+  // All regional lists share one name, to keep the set of histograms bounded
+  GetDATFileData(dat_file_path, "AdBlockRegional");
   base::FilePath resources_file_path =
       install_dir.AppendASCII(kAdBlockResourcesFilename);
 
@@ -15,6 +15,7 @@
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
@@ -69,7 +70,7 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
   }
 
   // Start all regional services associated with enabled filter lists
-  base::AutoLock lock(regional_services_lock_);
+  AdBlockEngineLock::AutoWriteLock lock(&regional_services_lock_);
   const base::DictionaryValue* regional_filters_dict =
       local_state->GetDictionary(kAdBlockRegionalFilters);
   for (base::DictionaryValue::Iterator it(*regional_filters_dict);
@@ -87,6 +88,7 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
           std::make_pair(uuid, std::move(regional_service)));
     }
   }
+  lists_generation_++;
 }
 
 void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
@@ -108,7 +110,7 @@ bool AdBlockRegionalServiceManager::IsInitialized() const {
 }
 
 bool AdBlockRegionalServiceManager::Start() {
-  base::AutoLock lock(regional_services_lock_);
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
     regional_service.second->Start();
   }
@@ -123,11 +125,21 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* matching_exception_filter,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
-  base::AutoLock lock(regional_services_lock_);
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            matching_exception_filter,
+                            cancel_request_explicitly, mock_data_url);
+}
+
+bool AdBlockRegionalServiceManager::ShouldStartRequest(
+    const AdBlockRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
     if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly, mock_data_url)) {
+            request, matching_exception_filter, cancel_request_explicitly,
+            mock_data_url)) {
       return false;
     }
     if (matching_exception_filter && *matching_exception_filter) {
@@ -140,7 +152,7 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
 
 void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
                                               bool enabled) {
-  base::AutoLock lock(regional_services_lock_);
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
     regional_service.second->EnableTag(tag, enabled);
   }
@@ -148,7 +160,7 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
 
 void AdBlockRegionalServiceManager::AddResources(
     const std::string& resources) {
-  base::AutoLock lock(regional_services_lock_);
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
     regional_service.second->AddResources(resources);
   }
@@ -160,7 +172,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
 
   // Enable or disable the specified filter list
   {
-    base::AutoLock lock(regional_services_lock_);
+    AdBlockEngineLock::AutoWriteLock lock(&regional_services_lock_);
     auto it = regional_services_.find(uuid);
     if (enabled) {
       DCHECK(it == regional_services_.end());
@@ -173,6 +185,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
       it->second->Unregister();
       regional_services_.erase(it);
     }
+    lists_generation_++;
   }
 
   // Update preferences to reflect enabled/disabled state of specified
@@ -183,9 +196,23 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
                      base::Unretained(this), uuid, enabled));
 }
 
+void AdBlockRegionalServiceManager::GetGenerations(
+    uint64_t* lists_generation,
+    uint64_t* engines_generation) {
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
+  *lists_generation = lists_generation_;
+  // Engine generations only grow, so while the set of lists is unchanged
+  // their sum changes whenever one of them does.
+  *engines_generation = 0;
+  for (const auto& regional_service : regional_services_) {
+    *engines_generation += regional_service.second->engine_generation();
+  }
+}
+
 base::Optional<base::Value>
 AdBlockRegionalServiceManager::UrlCosmeticResources(
         const std::string& url) {
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   auto it = this->regional_services_.begin();
   if (it == this->regional_services_.end()) {
     return base::Optional<base::Value>();
@@ -213,6 +240,7 @@ AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
+  AdBlockEngineLock::AutoReadLock lock(&regional_services_lock_);
   auto it = this->regional_services_.begin();
   if (it == this->regional_services_.end()) {
     return base::Optional<base::Value>();
@@ -14,9 +14,9 @@
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/optional.h"
-#include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_lock.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
 
@@ -31,6 +31,7 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 class AdBlockRegionalService;
+struct AdBlockRequest;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -50,9 +51,17 @@ class AdBlockRegionalServiceManager {
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url);
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
+  // Reports the number of filter list changes, and a generation which changes
+  // whenever the engine of an enabled list changes.
+  void GetGenerations(uint64_t* lists_generation,
+                      uint64_t* engines_generation);
 
   base::Optional<base::Value> UrlCosmeticResources(
           const std::string& url);
@@ -69,9 +78,13 @@ class AdBlockRegionalServiceManager {
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
   bool initialized_;
-  base::Lock regional_services_lock_;
+  // Matches take this for reading so that they can run concurrently on the
+  // thread pool; adding or removing a regional service takes it for writing.
+  AdBlockEngineLock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  // Bumped whenever a list is enabled or disabled, under the write lock.
+  uint64_t lists_generation_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalServiceManager);
 };
@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// The engine inputs for a single request. It is built once per request and
+// then matched against the default, regional and custom filter engines, so
+// the URL copies, the third-party check and the resource type string are not
+// recomputed for every engine.
+struct AdBlockRequest {
+  AdBlockRequest(const GURL& url,
+                 blink::mojom::ResourceType resource_type,
+                 const std::string& tab_host);
+  // For callers that already know whether |url| is third-party relative to
+  // |tab_host|.
+  AdBlockRequest(const GURL& url,
+                 blink::mojom::ResourceType resource_type,
+                 const std::string& tab_host,
+                 bool is_third_party);
+  ~AdBlockRequest();
+
+  const std::string url_spec;
+  const std::string host;
+  const std::string tab_host;
+  const std::string resource_type;
+  const bool is_third_party;
+  // Identifies the request for AdBlockDecisionCache: the decision of an
+  // engine only depends on the tab host, the URL and the resource type.
+  const std::string cache_key;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockRequest);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
@@ -0,0 +1,45 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::AdBlockRequest;
+
+TEST(AdBlockRequestTest, FirstParty) {
+  const AdBlockRequest request(GURL("https://cdn.brave.com/script.js"),
+                               blink::mojom::ResourceType::kScript,
+                               "www.brave.com");
+  EXPECT_EQ("https://cdn.brave.com/script.js", request.url_spec);
+  EXPECT_EQ("cdn.brave.com", request.host);
+  EXPECT_EQ("www.brave.com", request.tab_host);
+  EXPECT_EQ("script", request.resource_type);
+  EXPECT_FALSE(request.is_third_party);
+}
+
+TEST(AdBlockRequestTest, ThirdParty) {
+  const AdBlockRequest request(GURL("https://ads.example.com/pixel.gif"),
+                               blink::mojom::ResourceType::kImage,
+                               "brave.com");
+  EXPECT_EQ("image", request.resource_type);
+  EXPECT_TRUE(request.is_third_party);
+}
+
+TEST(AdBlockRequestTest, PrivateRegistry) {
+  const AdBlockRequest request(GURL("https://foo.github.io/"),
+                               blink::mojom::ResourceType::kSubFrame,
+                               "bar.github.io");
+  EXPECT_EQ("sub_frame", request.resource_type);
+  EXPECT_TRUE(request.is_third_party);
+}
+
+TEST(AdBlockRequestTest, UnmappedResourceType) {
+  const AdBlockRequest request(GURL("https://brave.com/sw.js"),
+                               blink::mojom::ResourceType::kServiceWorker,
+                               "brave.com");
+  EXPECT_EQ("", request.resource_type);
+}
@@ -71,7 +71,7 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
                                       const base::FilePath& install_dir,
                                       const std::string& manifest) {
   base::FilePath dat_file_path = install_dir.AppendASCII(DAT_FILE);
-  GetDATFileData(dat_file_path);
+  GetDATFileData(dat_file_path, "AdBlockDefault");
 
   base::FilePath resources_file_path =
       install_dir.AppendASCII(kAdBlockResourcesFilename);
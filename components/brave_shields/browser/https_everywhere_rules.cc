@@ -0,0 +1,218 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::vector<std::string> SplitLabels(const std::string& s) {
+  std::vector<std::string> labels = base::SplitString(
+      s, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  // A trailing dot does not produce an extra label.
+  if (!labels.empty() && labels.back().empty())
+    labels.pop_back();
+  return labels;
+}
+
+const std::string* FindString(const base::Value& dict, const char* key) {
+  const base::Value* value = dict.FindKey(key);
+  if (!value || !value->is_string())
+    return nullptr;
+  return &value->GetString();
+}
+
+}  // namespace
+
+HTTPSEverywhereRules::Rule::Rule() = default;
+HTTPSEverywhereRules::Rule::Rule(Rule&& other) = default;
+HTTPSEverywhereRules::Rule::~Rule() = default;
+
+HTTPSEverywhereRules::RuleSet::RuleSet() = default;
+HTTPSEverywhereRules::RuleSet::RuleSet(RuleSet&& other) = default;
+HTTPSEverywhereRules::RuleSet::~RuleSet() = default;
+
+HTTPSEverywhereRules::HostNode::HostNode() = default;
+HTTPSEverywhereRules::HostNode::~HostNode() = default;
+
+HTTPSEverywhereRules::HTTPSEverywhereRules() = default;
+HTTPSEverywhereRules::~HTTPSEverywhereRules() = default;
+
+bool HTTPSEverywhereRules::AddRuleSets(const std::string& key,
+                                       const std::string& json) {
+  std::vector<std::string> labels = SplitLabels(key);
+  if (labels.empty())
+    return false;
+
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return false;
+
+  auto rule_sets = std::make_unique<RuleSetList>();
+  for (const auto& rule_set_value : json_object->GetList()) {
+    if (!rule_set_value.is_dict())
+      continue;
+
+    RuleSet rule_set;
+    const base::Value* exclusions = rule_set_value.FindKey("e");
+    if (exclusions && exclusions->is_list()) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = FindString(exclusion, "p");
+        if (!pattern)
+          continue;
+        const re2::RE2* regex =
+            InternPattern(CorrecttoRuleToRE2Engine(*pattern));
+        if (regex)
+          rule_set.exclusions.push_back(regex);
+      }
+    }
+
+    const base::Value* rules = rule_set_value.FindKey("r");
+    rule_set.has_rules = rules && rules->is_list();
+    if (rule_set.has_rules) {
+      for (const auto& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict())
+          continue;
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.default_rule = true;
+          rule_set.rules.push_back(std::move(rule));
+          continue;
+        }
+        const std::string* from = FindString(rule_value, "f");
+        const std::string* to = FindString(rule_value, "t");
+        if (!from || !to)
+          continue;
+        rule.from = InternPattern(*from);
+        if (!rule.from)
+          continue;
+        rule.to = CorrecttoRuleToRE2Engine(*to);
+        rule_set.rules.push_back(std::move(rule));
+      }
+    }
+    rule_sets->push_back(std::move(rule_set));
+  }
+
+  bool wildcard = labels.back() == "*";
+  if (wildcard)
+    labels.pop_back();
+
+  HostNode* node = &root_;
+  for (const auto& label : labels) {
+    std::unique_ptr<HostNode>& child = node->children[label];
+    if (!child)
+      child = std::make_unique<HostNode>();
+    node = child.get();
+  }
+  if (wildcard)
+    node->wildcard = std::move(rule_sets);
+  else
+    node->exact = std::move(rule_sets);
+  key_count_++;
+  return true;
+}
+
+std::string HTTPSEverywhereRules::ApplyRules(
+    const std::string& host,
+    const std::string& url_spec) const {
+  const std::vector<std::string> labels = SplitLabels(host);
+  const size_t label_count = labels.size();
+  if (label_count < 2)
+    return std::string();
+
+  // Candidates are tried from the most specific one: the exact host first,
+  // then the wildcard entries of its parents, never including the TLD.
+  const RuleSetList* exact = nullptr;
+  std::vector<const RuleSetList*> wildcards;
+  const HostNode* node = &root_;
+  for (size_t depth = 1; depth <= label_count; ++depth) {
+    auto it = node->children.find(labels[label_count - depth]);
+    if (it == node->children.end())
+      break;
+    node = it->second.get();
+    if (depth == label_count) {
+      exact = node->exact.get();
+    } else if (depth >= 2 && node->wildcard) {
+      wildcards.push_back(node->wildcard.get());
+    }
+  }
+
+  if (exact) {
+    std::string new_url = ApplyRuleSetList(*exact, url_spec);
+    if (!new_url.empty())
+      return new_url;
+  }
+  for (auto it = wildcards.rbegin(); it != wildcards.rend(); ++it) {
+    std::string new_url = ApplyRuleSetList(**it, url_spec);
+    if (!new_url.empty())
+      return new_url;
+  }
+  return std::string();
+}
+
+// static
+std::string HTTPSEverywhereRules::ApplyRuleSetList(
+    const RuleSetList& rule_sets,
+    const std::string& url_spec) {
+  for (const auto& rule_set : rule_sets) {
+    for (const re2::RE2* exclusion : rule_set.exclusions) {
+      if (re2::RE2::FullMatch(url_spec, *exclusion))
+        return std::string();
+    }
+
+    if (!rule_set.has_rules)
+      return std::string();
+
+    for (const auto& rule : rule_set.rules) {
+      if (rule.default_rule) {
+        std::string new_url(url_spec);
+        return new_url.insert(4, "s");
+      }
+      std::string new_url(url_spec);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != url_spec) {
+        return new_url;
+      }
+    }
+  }
+  return std::string();
+}
+
+const re2::RE2* HTTPSEverywhereRules::InternPattern(
+    const std::string& pattern) {
+  std::unique_ptr<re2::RE2>& regex = patterns_[pattern];
+  if (!regex) {
+    regex = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+    if (!regex->ok())
+      VLOG(1) << "Invalid HTTPS Everywhere pattern: " << pattern;
+  }
+  return regex->ok() ? regex.get() : nullptr;
+}
+
+// static
+std::string HTTPSEverywhereRules::CorrecttoRuleToRE2Engine(
+    const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,94 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// In-memory, precompiled form of the HTTPS Everywhere rulesets. All rule JSON
+// is decoded and every regular expression is compiled once at load time, so
+// that a lookup only walks a reversed-label host trie and runs the already
+// compiled expressions.
+class HTTPSEverywhereRules {
+ public:
+  HTTPSEverywhereRules();
+  ~HTTPSEverywhereRules();
+
+  // Adds the rulesets stored under |key|, which uses the reversed-label
+  // format of the HTTPS Everywhere database ("com.example" for an exact host,
+  // "com.example.*" for every subdomain of example.com). |json| is the list
+  // of rulesets for that key. Returns false if |json| could not be decoded.
+  bool AddRuleSets(const std::string& key, const std::string& json);
+
+  // Returns the HTTPS version of |url_spec| for |host|, or an empty string if
+  // no rule applies.
+  std::string ApplyRules(const std::string& host,
+                         const std::string& url_spec) const;
+
+  size_t key_count() const { return key_count_; }
+  size_t pattern_count() const { return patterns_.size(); }
+
+  static std::string CorrecttoRuleToRE2Engine(const std::string& to);
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&& other);
+    ~Rule();
+
+    // Rules with the "d" key just upgrade the scheme.
+    bool default_rule = false;
+    const re2::RE2* from = nullptr;
+    std::string to;
+  };
+
+  struct RuleSet {
+    RuleSet();
+    RuleSet(RuleSet&& other);
+    ~RuleSet();
+
+    std::vector<const re2::RE2*> exclusions;
+    // False when the ruleset has no "r" list, which stops the lookup.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  using RuleSetList = std::vector<RuleSet>;
+
+  struct HostNode {
+    HostNode();
+    ~HostNode();
+
+    std::unordered_map<std::string, std::unique_ptr<HostNode>> children;
+    std::unique_ptr<RuleSetList> exact;
+    std::unique_ptr<RuleSetList> wildcard;
+  };
+
+  const re2::RE2* InternPattern(const std::string& pattern);
+  static std::string ApplyRuleSetList(const RuleSetList& rule_sets,
+                                      const std::string& url_spec);
+
+  HostNode root_;
+  std::unordered_map<std::string, std::unique_ptr<re2::RE2>> patterns_;
+  size_t key_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereRules);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
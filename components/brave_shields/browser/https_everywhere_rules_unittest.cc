@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSEverywhereRules;
+
+TEST(HTTPSEverywhereRulesTest, DefaultRuleForExactHost) {
+  HTTPSEverywhereRules rules;
+  ASSERT_TRUE(rules.AddRuleSets("org.example", R"([{"r":[{"d":1}]}])"));
+
+  EXPECT_EQ("https://example.org/path",
+            rules.ApplyRules("example.org", "http://example.org/path"));
+  // Exact keys do not apply to subdomains.
+  EXPECT_EQ("",
+            rules.ApplyRules("www.example.org", "http://www.example.org/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, WildcardRewrite) {
+  HTTPSEverywhereRules rules;
+  ASSERT_TRUE(rules.AddRuleSets("com.foo.*",
+      R"([{"r":[{"f":"^http://(\\w+)\\.foo\\.com/","t":"https://$1.foo.com/"}]}])"));
+
+  EXPECT_EQ("https://www.foo.com/a",
+            rules.ApplyRules("www.foo.com", "http://www.foo.com/a"));
+  EXPECT_EQ("https://cdn.foo.com/b",
+            rules.ApplyRules("a.cdn.foo.com", "http://cdn.foo.com/b"));
+  // The wildcard only covers subdomains.
+  EXPECT_EQ("", rules.ApplyRules("foo.com", "http://foo.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, TopLevelWildcardIsIgnored) {
+  HTTPSEverywhereRules rules;
+  ASSERT_TRUE(rules.AddRuleSets("com.*", R"([{"r":[{"d":1}]}])"));
+  EXPECT_EQ("", rules.ApplyRules("bar.com", "http://bar.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, ExclusionStopsLookup) {
+  HTTPSEverywhereRules rules;
+  ASSERT_TRUE(rules.AddRuleSets("net.baz",
+      R"([{"e":[{"p":"^http://baz\\.net/plain"}],"r":[{"d":1}]}])"));
+
+  EXPECT_EQ("", rules.ApplyRules("baz.net", "http://baz.net/plain"));
+  EXPECT_EQ("https://baz.net/secure",
+            rules.ApplyRules("baz.net", "http://baz.net/secure"));
+}
+
+TEST(HTTPSEverywhereRulesTest, ExactHostPreferredOverWildcard) {
+  HTTPSEverywhereRules rules;
+  ASSERT_TRUE(rules.AddRuleSets("io.qux.*",
+      R"([{"r":[{"f":"^http://","t":"https://wildcard."}]}])"));
+  ASSERT_TRUE(rules.AddRuleSets("io.qux.www",
+      R"([{"r":[{"f":"^http://","t":"https://exact."}]}])"));
+
+  EXPECT_EQ("https://exact.www.qux.io/",
+            rules.ApplyRules("www.qux.io", "http://www.qux.io/"));
+  EXPECT_EQ("https://wildcard.m.qux.io/",
+            rules.ApplyRules("m.qux.io", "http://m.qux.io/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, InvalidInput) {
+  HTTPSEverywhereRules rules;
+  EXPECT_FALSE(rules.AddRuleSets("com.invalid", "not json"));
+  EXPECT_FALSE(rules.AddRuleSets("com.invalid", R"({"r":[]})"));
+  EXPECT_EQ(0u, rules.key_count());
+
+  // Patterns that fail to compile are dropped.
+  ASSERT_TRUE(rules.AddRuleSets("com.broken",
+      R"([{"r":[{"f":"(","t":"https://"}]}])"));
+  EXPECT_EQ("", rules.ApplyRules("broken.com", "http://broken.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, PatternsAreInterned) {
+  HTTPSEverywhereRules rules;
+  const char kRuleSets[] = R"([{"r":[{"f":"^http:","t":"https:"}]}])";
+  ASSERT_TRUE(rules.AddRuleSets("com.one", kRuleSets));
+  ASSERT_TRUE(rules.AddRuleSets("com.two", kRuleSets));
+  EXPECT_EQ(2u, rules.key_count());
+  EXPECT_EQ(1u, rules.pattern_count());
+}
@@ -13,6 +13,11 @@ namespace features {
 const base::Feature kBraveAdblockCosmeticFiltering{
     "BraveAdblockCosmeticFiltering",
     base::FEATURE_ENABLED_BY_DEFAULT};
+// Run ad-block matching on the thread pool instead of the single sequenced
+// component task runner.
+const base::Feature kBraveAdblockParallelMatching{
+    "BraveAdblockParallelMatching",
+    base::FEATURE_DISABLED_BY_DEFAULT};
 
 }  // namespace features
 }  // namespace brave_shields
@@ -49,11 +49,10 @@ GURL GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
+bool IsBraveShieldsDown(const GURL& primary_url,
                         const GURL& secondary_url,
                         const ContentSettingsForOneType& rules) {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
 
   for (const auto& rule : rules) {
     if (rule.primary_pattern.Matches(primary_url) &&
@@ -66,8 +65,25 @@ bool IsBraveShieldsDown(const blink::WebFrame* frame,
   return setting == CONTENT_SETTING_BLOCK;
 }
 
+BraveFarblingLevel GetBraveFarblingLevelForSetting(ContentSetting setting) {
+  if (setting == CONTENT_SETTING_BLOCK) {
+    VLOG(1) << "farbling level MAXIMUM";
+    return BraveFarblingLevel::MAXIMUM;
+  } else if (setting == CONTENT_SETTING_ALLOW) {
+    VLOG(1) << "farbling level OFF";
+    return BraveFarblingLevel::OFF;
+  } else {
+    VLOG(1) << "farbling level BALANCED";
+    return BraveFarblingLevel::BALANCED;
+  }
+}
+
 }  // namespace
 
+BraveContentSettingsAgentImpl::ShieldsSnapshot::ShieldsSnapshot() = default;
+
+BraveContentSettingsAgentImpl::ShieldsSnapshot::~ShieldsSnapshot() = default;
+
 BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
     content::RenderFrame* render_frame,
     bool should_whitelist,
@@ -102,6 +118,7 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
   }
+  shields_snapshot_.reset();
 
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(
       is_same_document_navigation, transition);
@@ -134,7 +151,7 @@ bool BraveContentSettingsAgentImpl::AllowScript(
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
   allow = allow ||
-    IsBraveShieldsDown(frame, secondary_url) ||
+    IsBraveShieldsDown() ||
     IsScriptTemporilyAllowed(secondary_url);
 
   return allow;
@@ -165,7 +182,7 @@ bool BraveContentSettingsAgentImpl::AllowScriptFromSource(
 
   allow = allow ||
     should_white_list ||
-    IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
+    IsBraveShieldsDownForScript(secondary_url) ||
     IsScriptTemporilyAllowed(secondary_url);
 
   if (!allow) {
@@ -180,22 +197,92 @@ void BraveContentSettingsAgentImpl::DidBlockFingerprinting(
   Send(new BraveViewHostMsg_FingerprintingBlocked(routing_id(), details));
 }
 
-bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
-    const blink::WebFrame* frame,
-    const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+bool BraveContentSettingsAgentImpl::IsShieldsSnapshotValid() const {
+  return shields_snapshot_ &&
+         shields_snapshot_->rules == content_setting_rules_ &&
+         shields_snapshot_->rules_generation ==
+             content_setting_rules_->generation &&
+         // rules edited in place keep their generation
+         shields_snapshot_->brave_shields_rules_size ==
+             content_setting_rules_->brave_shields_rules.size() &&
+         shields_snapshot_->fingerprinting_rules_size ==
+             content_setting_rules_->fingerprinting_rules.size() &&
+         shields_snapshot_->autoplay_rules_size ==
+             content_setting_rules_->autoplay_rules.size();
+}
+
+BraveContentSettingsAgentImpl::ShieldsSnapshot*
+BraveContentSettingsAgentImpl::GetShieldsSnapshot() {
+  if (!content_setting_rules_)
+    return nullptr;
+  if (IsShieldsSnapshotValid())
+    return &shields_snapshot_.value();
+
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  const GURL secondary_url(
+      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
+
+  shields_snapshot_.emplace();
+  ShieldsSnapshot& snapshot = shields_snapshot_.value();
+  snapshot.rules = content_setting_rules_;
+  snapshot.rules_generation = content_setting_rules_->generation;
+  snapshot.brave_shields_rules_size =
+      content_setting_rules_->brave_shields_rules.size();
+  snapshot.fingerprinting_rules_size =
+      content_setting_rules_->fingerprinting_rules.size();
+  snapshot.autoplay_rules_size = content_setting_rules_->autoplay_rules.size();
+
+  snapshot.primary_url = GetOriginOrURL(frame);
+  snapshot.shields_down = ::content_settings::IsBraveShieldsDown(
+      snapshot.primary_url, secondary_url,
+      content_setting_rules_->brave_shields_rules);
+  snapshot.farbling_level = GetBraveFarblingLevelForSetting(
+      snapshot.shields_down
+          ? CONTENT_SETTING_ALLOW
+          : GetBraveFPContentSettingFromRules(
+                content_setting_rules_->fingerprinting_rules,
+                snapshot.primary_url));
+  snapshot.autoplay_setting = GetContentSettingFromRules(
+      content_setting_rules_->autoplay_rules, frame, secondary_url);
+  return &snapshot;
+}
+
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDown() {
+  ShieldsSnapshot* snapshot = GetShieldsSnapshot();
+  return !snapshot || snapshot->shields_down;
+}
+
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDownForScript(
+    const GURL& script_url) {
+  ShieldsSnapshot* snapshot = GetShieldsSnapshot();
+  if (!snapshot)
+    return true;
+
+  // Patterns only look at the path of file URLs, and opaque origins such as
+  // data URLs can't be used as keys
+  if (!script_url.SchemeIsHTTPOrHTTPS()) {
+    return ::content_settings::IsBraveShieldsDown(
+        snapshot->primary_url, script_url,
+        content_setting_rules_->brave_shields_rules);
+  }
+
+  const std::string script_origin = script_url.GetOrigin().spec();
+  auto it = snapshot->script_shields_down.find(script_origin);
+  if (it != snapshot->script_shields_down.end())
+    return it->second;
+
+  const bool shields_down = ::content_settings::IsBraveShieldsDown(
+      snapshot->primary_url, script_url,
+      content_setting_rules_->brave_shields_rules);
+  snapshot->script_shields_down.emplace(script_origin, shields_down);
+  return shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(
-      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  if (IsBraveShieldsDown()) {
     return true;
   }
 
@@ -203,31 +290,10 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    if (IsBraveShieldsDown(
-            frame,
-            url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL())) {
-      setting = CONTENT_SETTING_ALLOW;
-    } else {
-      setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules,
-          GetOriginOrURL(frame));
-    }
-  }
-
-  if (setting == CONTENT_SETTING_BLOCK) {
-    VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
-  } else if (setting == CONTENT_SETTING_ALLOW) {
-    VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
-  } else {
-    VLOG(1) << "farbling level BALANCED";
+  ShieldsSnapshot* snapshot = GetShieldsSnapshot();
+  if (!snapshot)
     return BraveFarblingLevel::BALANCED;
-  }
+  return snapshot->farbling_level;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool default_value) {
@@ -241,10 +307,8 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool default_value) {
 
   // respect user's site blocklist, if any
   bool ask = false;
-  if (content_setting_rules_) {
-    ContentSetting setting = GetContentSettingFromRules(
-        content_setting_rules_->autoplay_rules, frame,
-        url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
+  if (ShieldsSnapshot* snapshot = GetShieldsSnapshot()) {
+    ContentSetting setting = snapshot->autoplay_setting;
     if (setting == CONTENT_SETTING_BLOCK) {
       VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
       return false;
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -50,10 +52,37 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
                            AutoplayBlockedByDefault);
   FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
                            AutoplayAllowedByDefault);
-
-  bool IsBraveShieldsDown(
-      const blink::WebFrame* frame,
-      const GURL& secondary_url);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
+                           AutoplayRulesReplaced);
+
+  // Shields decisions for the current document. They are computed on first
+  // use after a commit or a rules update, so that the per-call checks don't
+  // scan the rules again.
+  struct ShieldsSnapshot {
+    ShieldsSnapshot();
+    ~ShieldsSnapshot();
+
+    // Rules the decisions were computed from.
+    const RendererContentSettingRules* rules = nullptr;
+    uint64_t rules_generation = 0;
+    size_t brave_shields_rules_size = 0;
+    size_t fingerprinting_rules_size = 0;
+    size_t autoplay_rules_size = 0;
+
+    GURL primary_url;
+    bool shields_down = false;
+    BraveFarblingLevel farbling_level = BraveFarblingLevel::BALANCED;
+    ContentSetting autoplay_setting = CONTENT_SETTING_DEFAULT;
+    // Shields state for scripts, keyed by script origin
+    base::flat_map<std::string, bool> script_shields_down;
+  };
+
+  // Returns null when there are no rules to compute the snapshot from.
+  ShieldsSnapshot* GetShieldsSnapshot();
+  bool IsShieldsSnapshotValid() const;
+
+  bool IsBraveShieldsDown();
+  bool IsBraveShieldsDownForScript(const GURL& script_url);
 
   // RenderFrameObserver
   bool OnMessageReceived(const IPC::Message& message) override;
@@ -73,6 +102,8 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  base::Optional<ShieldsSnapshot> shields_snapshot_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -97,4 +97,34 @@ TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
   EXPECT_FALSE(agent.AllowAutoplay(true));
 }
 
+TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
+       AutoplayRulesReplaced) {
+  LoadHTMLWithUrlOverride("<html>Autoplay</html>", "https://example.com/");
+
+  // Set the default autoplay blocking setting.
+  RendererContentSettingRules content_setting_rules;
+  content_setting_rules.autoplay_rules.push_back(ContentSettingPatternSource(
+      ContentSettingsPattern::Wildcard(), ContentSettingsPattern::Wildcard(),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(CONTENT_SETTING_BLOCK)),
+      std::string(), false));
+
+  BraveContentSettingsAgentImpl agent(
+      view_->GetMainRenderFrame(), false,
+      std::make_unique<ContentSettingsAgentImpl::Delegate>());
+  agent.SetContentSettingRules(&content_setting_rules);
+  EXPECT_FALSE(agent.AllowAutoplay(true));
+
+  // Replace the rules with the same number of rules, as a rules update from
+  // the browser does.
+  RendererContentSettingRules updated_rules;
+  updated_rules.autoplay_rules.push_back(ContentSettingPatternSource(
+      ContentSettingsPattern::Wildcard(), ContentSettingsPattern::Wildcard(),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
+      std::string(), false));
+  content_setting_rules = updated_rules;
+  EXPECT_TRUE(agent.AllowAutoplay(true));
+}
+
 }  // namespace content_settings
@@ -0,0 +1,270 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_extension_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/base64.h"
+#include "base/bind_helpers.h"
+#include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_file_value_serializer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "brave/common/network_constants.h"
+#include "brave/components/brave_component_updater/browser/features.h"
+#include "brave/components/brave_component_updater/browser/switches.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
+#include "extensions/common/constants.h"
+#include "extensions/common/extension.h"
+#include "extensions/common/file_util.h"
+#include "extensions/common/manifest_constants.h"
+
+using extensions::Extension;
+using extensions::Manifest;
+
+namespace greaselion {
+
+namespace {
+
+// Converted rules are kept under the profile directory, next to the extensions
+// install directory, so that they survive restarts.
+constexpr char kGreaselionCacheDirName[] = "Greaselion";
+// Bump this whenever the generated manifest changes so that old conversions
+// are not reused.
+constexpr char kGreaselionCacheFormatVersion[] = "1";
+// Cached conversions that haven't been used for this long are deleted.
+constexpr base::TimeDelta kGreaselionCacheMaxAge =
+    base::TimeDelta::FromDays(30);
+
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a public
+// key.
+std::string GetGreaselionPublicKey(const std::string& script_name) {
+  char raw[crypto::kSHA256Length] = {0};
+  std::string key;
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
+                             raw,
+                             crypto::kSHA256Length);
+  } else {
+    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
+                             raw,
+                             crypto::kSHA256Length);
+  }
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+void UpdateHash(crypto::SecureHash* hash, const std::string& value) {
+  // Every field is terminated so that adjacent fields can't be confused.
+  hash->Update(value.data(), value.size());
+  hash->Update("", 1);
+}
+
+scoped_refptr<Extension> LoadGreaselionExtension(
+    const base::FilePath& extension_dir) {
+  std::string error;
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load Greaselion extension";
+    LOG(ERROR) << error;
+  }
+  return extension;
+}
+
+// Writes the unpacked extension for |rule| into |extension_dir|.
+bool WriteGreaselionExtension(
+    const GreaselionRule& rule,
+    const std::string& public_key,
+    const std::vector<std::string>& script_contents,
+    const base::FilePath& extension_dir) {
+  // Create the manifest
+  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
+
+  // manifest version is always 2
+  // see kModernManifestVersion in src/extensions/common/extension.cc
+  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+
+  root->SetStringPath(extensions::manifest_keys::kName, rule.name());
+  root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
+  root->SetStringPath(extensions::manifest_keys::kDescription, "");
+  root->SetStringPath(extensions::manifest_keys::kPublicKey, public_key);
+
+  auto js_files = std::make_unique<base::ListValue>();
+  for (auto script : rule.scripts())
+    js_files->AppendString(script.BaseName().value());
+
+  auto matches = std::make_unique<base::ListValue>();
+  for (auto url_pattern : rule.url_patterns())
+    matches->AppendString(url_pattern);
+
+  auto content_script = std::make_unique<base::DictionaryValue>();
+  content_script->Set(extensions::manifest_keys::kMatches, std::move(matches));
+  content_script->Set(extensions::manifest_keys::kJs, std::move(js_files));
+  // All Greaselion scripts default to document end.
+  content_script->SetStringPath(extensions::manifest_keys::kRunAt,
+      rule.run_at() == extensions::manifest_values::kRunAtDocumentStart
+        ? extensions::manifest_values::kRunAtDocumentStart
+        : extensions::manifest_values::kRunAtDocumentEnd);
+
+  auto content_scripts = std::make_unique<base::ListValue>();
+  content_scripts->Append(std::move(content_script));
+
+  root->Set(extensions::manifest_keys::kContentScripts,
+            std::move(content_scripts));
+
+  base::FilePath manifest_path =
+      extension_dir.Append(extensions::kManifestFilename);
+  JSONFileValueSerializer serializer(manifest_path);
+  // If you read the header file for this function, it says not to use it
+  // outside unit tests because it writes to disk (which blocks the thread). I
+  // just want to assure you that it's okay. We want to write to disk here, and
+  // we're already on a task runner that allows blocking.
+  if (!serializer.Serialize(*root)) {
+    LOG(ERROR) << "Could not write Greaselion manifest";
+    return false;
+  }
+
+  // Write the script files to our extension directory.
+  const std::vector<base::FilePath> scripts = rule.scripts();
+  DCHECK_EQ(scripts.size(), script_contents.size());
+  for (size_t i = 0; i < scripts.size(); ++i) {
+    const std::string& contents = script_contents[i];
+    if (base::WriteFile(extension_dir.Append(scripts[i].BaseName()),
+                        contents.data(), contents.size()) !=
+        static_cast<int>(contents.size())) {
+      LOG(ERROR) << "Could not copy Greaselion script at path: "
+          << scripts[i].LossyDisplayName();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+base::FilePath GetGreaselionCacheDir(const base::FilePath& extensions_dir) {
+  if (extensions_dir.empty())
+    return base::FilePath();
+  return extensions_dir.DirName().AppendASCII(kGreaselionCacheDirName);
+}
+
+std::string GetGreaselionCacheKey(const GreaselionRule& rule,
+                                  const std::string& public_key,
+                                  std::vector<std::string>* script_contents) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  UpdateHash(hash.get(), kGreaselionCacheFormatVersion);
+  UpdateHash(hash.get(), rule.name());
+  UpdateHash(hash.get(), public_key);
+  UpdateHash(hash.get(), rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    UpdateHash(hash.get(), url_pattern);
+
+  for (const auto& script : rule.scripts()) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+          << script.LossyDisplayName();
+      return std::string();
+    }
+    UpdateHash(hash.get(), script.BaseName().AsUTF8Unsafe());
+    UpdateHash(hash.get(), contents);
+    script_contents->push_back(std::move(contents));
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)));
+}
+
+scoped_refptr<Extension> ConvertGreaselionRuleToExtension(
+    GreaselionRule* rule,
+    const base::FilePath& extensions_dir) {
+  const base::FilePath cache_dir = GetGreaselionCacheDir(extensions_dir);
+  if (cache_dir.empty() || !base::CreateDirectory(cache_dir)) {
+    LOG(ERROR) << "Could not create Greaselion cache directory";
+    return nullptr;
+  }
+
+  const std::string public_key = GetGreaselionPublicKey(rule->name());
+  std::vector<std::string> script_contents;
+  const std::string cache_key =
+      GetGreaselionCacheKey(*rule, public_key, &script_contents);
+  if (cache_key.empty())
+    return nullptr;
+
+  const base::FilePath extension_dir = cache_dir.AppendASCII(cache_key);
+  if (base::PathExists(extension_dir.Append(extensions::kManifestFilename))) {
+    scoped_refptr<Extension> extension =
+        LoadGreaselionExtension(extension_dir);
+    if (extension) {
+      DVLOG(2) << "Reusing converted Greaselion rule " << rule->name();
+      const base::Time now = base::Time::Now();
+      base::TouchFile(extension_dir, now, now);
+      return extension;
+    }
+  }
+  // Whatever is left of an unusable or interrupted conversion is replaced.
+  base::DeleteFileRecursively(extension_dir);
+
+  base::ScopedTempDir temp_dir;
+  if (!temp_dir.CreateUniqueTempDirUnderPath(cache_dir)) {
+    LOG(ERROR) << "Could not create Greaselion temp directory";
+    return nullptr;
+  }
+
+  if (!WriteGreaselionExtension(*rule, public_key, script_contents,
+                                temp_dir.GetPath())) {
+    return nullptr;
+  }
+
+  // The extension only shows up under its key once it's complete.
+  if (!base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension into the cache";
+    return nullptr;
+  }
+  ignore_result(temp_dir.Take());
+
+  DVLOG(2) << "Converted Greaselion rule " << rule->name();
+  return LoadGreaselionExtension(extension_dir);
+}
+
+void DeleteStaleGreaselionCacheEntries(const base::FilePath& extensions_dir) {
+  const base::FilePath cache_dir = GetGreaselionCacheDir(extensions_dir);
+  if (cache_dir.empty())
+    return;
+
+  const base::Time cutoff = base::Time::Now() - kGreaselionCacheMaxAge;
+  base::FileEnumerator enumerator(cache_dir, false,
+                                  base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    // Directories in use are touched on every load, so only conversions no
+    // rule has used lately and leftovers of interrupted ones are deleted.
+    if (enumerator.GetInfo().GetLastModifiedTime() < cutoff)
+      base::DeleteFileRecursively(path);
+  }
+}
+
+}  // namespace greaselion
@@ -0,0 +1,52 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
+#define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+
+namespace extensions {
+class Extension;
+}  // namespace extensions
+
+namespace greaselion {
+
+class GreaselionRule;
+
+// Greaselion rules are converted to unpacked extensions, which are kept in a
+// cache dir next to |extensions_dir| so that unchanged rules are only
+// converted once across restarts.
+//
+// NOTE: These functions do file IO and must run on the extension file task
+// runner, so that conversions and pruning never overlap.
+
+// Returns the cache dir for |extensions_dir|, or an empty path.
+base::FilePath GetGreaselionCacheDir(const base::FilePath& extensions_dir);
+
+// Reads the scripts of |rule| into |script_contents| and returns a key that
+// identifies the converted extension: a hash of everything that ends up in
+// its directory. Returns an empty string if a script can't be read.
+std::string GetGreaselionCacheKey(const GreaselionRule& rule,
+                                  const std::string& public_key,
+                                  std::vector<std::string>* script_contents);
+
+// Wraps a Greaselion rule in a component, reusing its cached conversion if
+// there is a valid one. Returns a valid extension, or nullptr.
+scoped_refptr<extensions::Extension> ConvertGreaselionRuleToExtension(
+    GreaselionRule* rule,
+    const base::FilePath& extensions_dir);
+
+// Deletes cached conversions that haven't been used recently, along with temp
+// directories left behind by interrupted conversions.
+void DeleteStaleGreaselionCacheEntries(const base::FilePath& extensions_dir);
+
+}  // namespace greaselion
+
+#endif  // BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
@@ -0,0 +1,157 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_extension_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "extensions/common/constants.h"
+#include "extensions/common/extension.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace greaselion {
+
+namespace {
+
+constexpr char kScriptName[] = "script.js";
+constexpr char kUrlPattern[] = "https://www.example.com/*";
+
+}  // namespace
+
+class GreaselionExtensionCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    resource_dir_ = temp_dir_.GetPath().AppendASCII("resources");
+    ASSERT_TRUE(base::CreateDirectory(resource_dir_));
+    extensions_dir_ = temp_dir_.GetPath().AppendASCII("Extensions");
+    WriteScript("console.log('greaselion');");
+  }
+
+ protected:
+  void WriteScript(const std::string& contents) {
+    ASSERT_TRUE(base::WriteFile(resource_dir_.AppendASCII(kScriptName),
+                                contents.data(), contents.size()) ==
+                static_cast<int>(contents.size()));
+  }
+
+  std::unique_ptr<GreaselionRule> MakeRule(const std::string& url_pattern) {
+    auto rule = std::make_unique<GreaselionRule>("test");
+    base::ListValue urls;
+    urls.AppendString(url_pattern);
+    base::ListValue scripts;
+    scripts.AppendString(kScriptName);
+    rule->Parse(nullptr, &urls, &scripts, "document_end", resource_dir_);
+    return rule;
+  }
+
+  scoped_refptr<extensions::Extension> Convert(
+      const std::string& url_pattern) {
+    return ConvertGreaselionRuleToExtension(MakeRule(url_pattern).get(),
+                                            extensions_dir_);
+  }
+
+  std::string GetCacheKey(const std::string& url_pattern,
+                          const std::string& public_key) {
+    std::vector<std::string> script_contents;
+    return GetGreaselionCacheKey(*MakeRule(url_pattern), public_key,
+                                 &script_contents);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath resource_dir_;
+  base::FilePath extensions_dir_;
+};
+
+TEST_F(GreaselionExtensionCacheTest, ReusesConversionAcrossRestarts) {
+  scoped_refptr<extensions::Extension> extension = Convert(kUrlPattern);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(GetGreaselionCacheDir(extensions_dir_),
+            extension->path().DirName());
+  // Anything written again would drop this file.
+  const base::FilePath marker = extension->path().AppendASCII("marker");
+  ASSERT_EQ(0, base::WriteFile(marker, "", 0));
+
+  // A new rule parsed from the same files, as after a restart.
+  scoped_refptr<extensions::Extension> reused = Convert(kUrlPattern);
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(extension->path(), reused->path());
+  EXPECT_EQ(extension->id(), reused->id());
+  EXPECT_TRUE(base::PathExists(marker));
+}
+
+TEST_F(GreaselionExtensionCacheTest, KeyChangesWithRuleAndScripts) {
+  const std::string key = GetCacheKey(kUrlPattern, "public_key");
+  ASSERT_FALSE(key.empty());
+  EXPECT_EQ(key, GetCacheKey(kUrlPattern, "public_key"));
+  EXPECT_NE(key, GetCacheKey("https://www.example.org/*", "public_key"));
+  EXPECT_NE(key, GetCacheKey(kUrlPattern, "other_public_key"));
+
+  WriteScript("console.log('updated');");
+  EXPECT_NE(key, GetCacheKey(kUrlPattern, "public_key"));
+}
+
+TEST_F(GreaselionExtensionCacheTest, ConvertsChangedScriptAgain) {
+  scoped_refptr<extensions::Extension> extension = Convert(kUrlPattern);
+  ASSERT_TRUE(extension);
+
+  const std::string updated_script = "console.log('updated');";
+  WriteScript(updated_script);
+  scoped_refptr<extensions::Extension> updated = Convert(kUrlPattern);
+  ASSERT_TRUE(updated);
+  EXPECT_NE(extension->path(), updated->path());
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(
+      updated->path().AppendASCII(kScriptName), &contents));
+  EXPECT_EQ(updated_script, contents);
+}
+
+TEST_F(GreaselionExtensionCacheTest, RebuildsCorruptConversion) {
+  scoped_refptr<extensions::Extension> extension = Convert(kUrlPattern);
+  ASSERT_TRUE(extension);
+  const std::string corrupt_manifest = "{ not json";
+  ASSERT_TRUE(base::WriteFile(
+                  extension->path().Append(extensions::kManifestFilename),
+                  corrupt_manifest.data(), corrupt_manifest.size()) ==
+              static_cast<int>(corrupt_manifest.size()));
+
+  scoped_refptr<extensions::Extension> rebuilt = Convert(kUrlPattern);
+  ASSERT_TRUE(rebuilt);
+  EXPECT_EQ(extension->path(), rebuilt->path());
+  EXPECT_EQ(extension->id(), rebuilt->id());
+}
+
+TEST_F(GreaselionExtensionCacheTest, PrunesUnusedConversions) {
+  scoped_refptr<extensions::Extension> unused = Convert(kUrlPattern);
+  ASSERT_TRUE(unused);
+  const std::string used_pattern = "https://www.example.org/*";
+  scoped_refptr<extensions::Extension> used = Convert(used_pattern);
+  ASSERT_TRUE(used);
+  const base::FilePath leftover =
+      GetGreaselionCacheDir(extensions_dir_).AppendASCII("leftover");
+  ASSERT_TRUE(base::CreateDirectory(leftover));
+
+  const base::Time long_ago = base::Time::Now() - base::TimeDelta::FromDays(31);
+  ASSERT_TRUE(base::TouchFile(unused->path(), long_ago, long_ago));
+  ASSERT_TRUE(base::TouchFile(used->path(), long_ago, long_ago));
+  ASSERT_TRUE(base::TouchFile(leftover, long_ago, long_ago));
+  // Reusing a conversion marks it as used.
+  ASSERT_TRUE(Convert(used_pattern));
+
+  DeleteStaleGreaselionCacheEntries(extensions_dir_);
+  EXPECT_FALSE(base::PathExists(unused->path()));
+  EXPECT_FALSE(base::PathExists(leftover));
+  EXPECT_TRUE(base::PathExists(used->path()));
+}
+
+}  // namespace greaselion
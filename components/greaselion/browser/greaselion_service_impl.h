@@ -13,6 +13,7 @@
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
@@ -71,6 +72,9 @@ class GreaselionServiceImpl : public GreaselionService {
   bool all_rules_installed_successfully_;
   bool update_in_progress_;
   int pending_installs_;
+  // Set once the first update, which happens at startup, has finished.
+  bool initial_update_done_;
+  base::TimeTicks update_start_time_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
@@ -40,6 +40,8 @@ namespace ntp_background_images {
 namespace {
 
 constexpr int kSIComponentUpdateCheckIntervalHours = 1;
+// Enough for the current and next wallpaper plus the logo.
+constexpr size_t kMaxImageCacheBytes = 16 * 1024 * 1024;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
 
@@ -56,6 +58,14 @@ std::string GetMappingTableData(const base::FilePath& installed_dir) {
   return contents;
 }
 
+scoped_refptr<base::RefCountedMemory> ReadImageFileToMemory(
+    const base::FilePath& image_file) {
+  std::string contents;
+  if (!base::ReadFileToString(image_file, &contents))
+    return nullptr;
+  return base::RefCountedString::TakeString(&contents);
+}
+
 void CacheSuperReferralData(const std::string& data_json,
                             const base::FilePath& installed_dir,
                             const base::FilePath& super_referral_cache_dir) {
@@ -133,6 +143,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
       local_pref_(local_pref),
       super_referral_cache_dir_(
           user_data_dir.AppendASCII("SuperReferralCache")),
+      image_cache_(ImageCache::NO_AUTO_EVICT),
       weak_factory_(this) {
 }
 
@@ -465,6 +476,8 @@ void NTPBackgroundImagesService::OnComponentReady(
   else
     si_installed_dir_ = installed_dir;
 
+  InvalidateImageCache();
+
   DVLOG(2) << __func__ << (is_super_referral ? ": NPT SR Component is ready"
                                              : ": NTP SI Component is ready");
 
@@ -480,6 +493,10 @@ void NTPBackgroundImagesService::OnComponentReady(
 void NTPBackgroundImagesService::OnGetComponentJsonData(
     bool is_super_referral,
     const std::string& json_string) {
+  // SR images are copied into |super_referral_cache_dir_| while the json is
+  // handled, so drop anything that was read from there in the meantime.
+  InvalidateImageCache();
+
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
@@ -524,6 +541,90 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
   }
 }
 
+void NTPBackgroundImagesService::GetImageData(
+    const base::FilePath& image_file,
+    ImageDataCallback callback) {
+  auto it = image_cache_.Get(image_file);
+  if (it != image_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  // A read started before the last component update may still be pending.
+  // Its result is for the previous component, so don't join it.
+  std::vector<ImageDataCallback>& callbacks =
+      pending_image_reads_[{image_file, image_cache_generation_}];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() == 1)
+    ReadImageFile(image_file);
+}
+
+void NTPBackgroundImagesService::PrefetchImage(
+    const base::FilePath& image_file) {
+  if (image_file.empty() ||
+      image_cache_.Peek(image_file) != image_cache_.end() ||
+      pending_image_reads_.count({image_file, image_cache_generation_})) {
+    return;
+  }
+
+  pending_image_reads_[{image_file, image_cache_generation_}];
+  ReadImageFile(image_file);
+}
+
+void NTPBackgroundImagesService::ReadImageFile(
+    const base::FilePath& image_file) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&ReadImageFileToMemory, image_file),
+      base::BindOnce(&NTPBackgroundImagesService::OnReadImageFile,
+                     weak_factory_.GetWeakPtr(),
+                     image_file,
+                     image_cache_generation_));
+}
+
+void NTPBackgroundImagesService::OnReadImageFile(
+    const base::FilePath& image_file,
+    uint64_t generation,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes && generation == image_cache_generation_)
+    AddToImageCache(image_file, bytes);
+
+  auto it = pending_image_reads_.find({image_file, generation});
+  if (it == pending_image_reads_.end())
+    return;
+
+  std::vector<ImageDataCallback> callbacks = std::move(it->second);
+  pending_image_reads_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPBackgroundImagesService::AddToImageCache(
+    const base::FilePath& image_file,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes->size() > kMaxImageCacheBytes)
+    return;
+
+  auto existing = image_cache_.Peek(image_file);
+  if (existing != image_cache_.end())
+    image_cache_bytes_ -= existing->second->size();
+
+  image_cache_bytes_ += bytes->size();
+  image_cache_.Put(image_file, std::move(bytes));
+
+  while (image_cache_bytes_ > kMaxImageCacheBytes) {
+    auto oldest = image_cache_.rbegin();
+    image_cache_bytes_ -= oldest->second->size();
+    image_cache_.Erase(oldest);
+  }
+}
+
+void NTPBackgroundImagesService::InvalidateImageCache() {
+  image_cache_.Clear();
+  image_cache_bytes_ = 0;
+  image_cache_generation_++;
+}
+
 void NTPBackgroundImagesService::MarkThisInstallIsNotSuperReferralForever() {
   local_pref_->Set(prefs::kNewTabPageCachedSuperReferralComponentInfo,
                    base::Value(base::Value::Type::DICTIONARY));
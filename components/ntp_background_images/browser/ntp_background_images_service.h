@@ -6,12 +6,19 @@
 #ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SERVICE_H_
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SERVICE_H_
 
+#include <stdint.h>
+
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
@@ -69,6 +76,17 @@ class NTPBackgroundImagesService {
 
   std::vector<std::string> GetCachedTopSitesFaviconList() const;
 
+  using ImageDataCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  // Runs |callback| with the contents of |image_file|, or with null if it
+  // can't be read. Recently used images are kept in memory so that new tab
+  // pages don't wait on disk reads.
+  void GetImageData(const base::FilePath& image_file,
+                    ImageDataCallback callback);
+  // Loads |image_file| into the image cache ahead of its first request.
+  void PrefetchImage(const base::FilePath& image_file);
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -104,6 +122,7 @@ class NTPBackgroundImagesService {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            ActiveInitiallyOptedIn);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest, ModelTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesServiceTest, ImageCacheTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
@@ -120,6 +139,17 @@ class NTPBackgroundImagesService {
   bool IsValidSuperReferralComponentInfo(
       const base::Value& component_info) const;
 
+  using ImageCache =
+      base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>;
+
+  void ReadImageFile(const base::FilePath& image_file);
+  void OnReadImageFile(const base::FilePath& image_file,
+                       uint64_t generation,
+                       scoped_refptr<base::RefCountedMemory> bytes);
+  void AddToImageCache(const base::FilePath& image_file,
+                       scoped_refptr<base::RefCountedMemory> bytes);
+  void InvalidateImageCache();
+
   void CacheTopSitesFaviconList();
   void RestoreCachedTopSitesFaviconList();
   void CheckSIComponentUpdate(const std::string& component_id);
@@ -157,6 +187,17 @@ class NTPBackgroundImagesService {
   // not show SI images until user chooses Brave default images. So, we should
   // know the exact timing whether SR assets is ready to use or not.
   base::Value initial_sr_component_info_;
+  // Image file contents, evicted in LRU order once they take more than
+  // |kMaxImageCacheBytes|.
+  ImageCache image_cache_;
+  size_t image_cache_bytes_ = 0;
+  // Bumped whenever a component is updated. Reads that were started for the
+  // previous component still answer their callbacks but are not cached.
+  uint64_t image_cache_generation_ = 0;
+  // Keyed by image file and the generation the read was started in.
+  std::map<std::pair<base::FilePath, uint64_t>,
+           std::vector<ImageDataCallback>>
+      pending_image_reads_;
   base::WeakPtrFactory<NTPBackgroundImagesService> weak_factory_;
 };
 
@@ -6,6 +6,10 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/test/task_environment.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -509,4 +513,59 @@ TEST_F(NTPBackgroundImagesServiceTest,
 
 #endif  // BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
+TEST_F(NTPBackgroundImagesServiceTest, ImageCacheTest) {
+  Init();
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath image_file =
+      temp_dir.GetPath().AppendASCII("background-1.jpg");
+  ASSERT_EQ(5, base::WriteFile(image_file, "first", 5));
+
+  std::string data;
+  auto get_image_data = [&]() {
+    data.clear();
+    service_->GetImageData(
+        image_file,
+        base::BindOnce(
+            [](std::string* data,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              if (bytes)
+                data->assign(bytes->front_as<char>(), bytes->size());
+            },
+            &data));
+    env_.RunUntilIdle();
+  };
+
+  // Prefetched image is served from memory.
+  service_->PrefetchImage(image_file);
+  env_.RunUntilIdle();
+  ASSERT_EQ(6, base::WriteFile(image_file, "second", 6));
+  get_image_data();
+  EXPECT_EQ("first", data);
+
+  // Component update drops cached images.
+  service_->InvalidateImageCache();
+  get_image_data();
+  EXPECT_EQ("second", data);
+
+  // A read pending across a component update is not joined, so the image is
+  // read again and cached.
+  service_->InvalidateImageCache();
+  service_->PrefetchImage(image_file);
+  service_->InvalidateImageCache();
+  get_image_data();
+  EXPECT_EQ("second", data);
+  ASSERT_EQ(5, base::WriteFile(image_file, "third", 5));
+  get_image_data();
+  EXPECT_EQ("second", data);
+
+  // Missing file is not cached.
+  ASSERT_TRUE(base::DeleteFile(image_file, false));
+  service_->InvalidateImageCache();
+  get_image_data();
+  EXPECT_TRUE(data.empty());
+  EXPECT_EQ(0UL, service_->image_cache_bytes_);
+}
+
 }  // namespace ntp_background_images
@@ -22,6 +22,18 @@ bool ViewCounterModel::ShouldShowBrandedWallpaper() const {
   return count_to_branded_wallpaper_ == 0;
 }
 
+int ViewCounterModel::GetNextWallpaperImageIndex() const {
+  if (total_image_count_ <= 0)
+    return current_wallpaper_image_index_;
+
+  // The current image is being shown, so the index moves on with the next
+  // page view. Otherwise the current image is still the one to show next.
+  if (ShouldShowBrandedWallpaper())
+    return (current_wallpaper_image_index_ + 1) % total_image_count_;
+
+  return current_wallpaper_image_index_;
+}
+
 void ViewCounterModel::ResetCurrentWallpaperImageIndex() {
   current_wallpaper_image_index_ = 0;
 }
@@ -28,6 +28,9 @@ class ViewCounterModel {
   }
 
   bool ShouldShowBrandedWallpaper() const;
+  // Returns the index of the image that the next branded wallpaper view will
+  // use.
+  int GetNextWallpaperImageIndex() const;
   void RegisterPageView();
   void ResetCurrentWallpaperImageIndex();
 
@@ -80,4 +80,26 @@ TEST(ViewCounterModelTest, NTPSuperReferralTest) {
   }
 }
 
+TEST(ViewCounterModelTest, NextWallpaperImageIndexTest) {
+  ViewCounterModel model;
+  model.set_total_image_count(kTestImageCount);
+
+  // Predicted index should be the one that the next branded view uses.
+  for (int i = 0; i < 10; ++i) {
+    const int next_index = model.GetNextWallpaperImageIndex();
+    do {
+      model.RegisterPageView();
+    } while (!model.ShouldShowBrandedWallpaper());
+    EXPECT_EQ(next_index, model.current_wallpaper_image_index());
+  }
+
+  model.Reset();
+  model.set_ignore_count_to_branded_wallpaper(true);
+  model.set_total_image_count(kTestImageCount);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ((i + 1) % kTestImageCount, model.GetNextWallpaperImageIndex());
+    model.RegisterPageView();
+  }
+}
+
 }  // namespace ntp_background_images
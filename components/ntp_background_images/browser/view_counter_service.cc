@@ -175,9 +175,28 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    PrefetchWallpaperImages();
   }
 }
 
+void ViewCounterService::PrefetchWallpaperImages() {
+  auto* data = GetCurrentBrandedWallpaperData();
+  if (!data || data->backgrounds.empty())
+    return;
+
+  const size_t count = data->backgrounds.size();
+  if (model_.ShouldShowBrandedWallpaper()) {
+    const size_t index = model_.current_wallpaper_image_index();
+    if (index < count)
+      service_->PrefetchImage(data->backgrounds[index].image_file);
+    service_->PrefetchImage(data->logo_image_file);
+  }
+
+  const size_t next_index = model_.GetNextWallpaperImageIndex();
+  if (next_index < count)
+    service_->PrefetchImage(data->backgrounds[next_index].image_file);
+}
+
 bool ViewCounterService::ShouldShowBrandedWallpaper() const {
   return IsBrandedWallpaperActive() && model_.ShouldShowBrandedWallpaper();
 }
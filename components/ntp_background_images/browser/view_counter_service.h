@@ -107,6 +107,9 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  // Warms the image cache of |service_| with the wallpaper that is about to
+  // be requested and with the one after it.
+  void PrefetchWallpaperImages();
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
   PrefService* prefs_ = nullptr;  // not owned
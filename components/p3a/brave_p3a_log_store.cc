@@ -20,6 +20,9 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Delay before pending changes are written to local state.
+constexpr base::TimeDelta kPersistDelay = base::TimeDelta::FromSeconds(10);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -56,30 +59,24 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  SchedulePersist(histogram_name);
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      dirty_entries_.insert(pair.first);
     }
   }
 
+  // The rotation is rare, so write its result right away.
+  PersistPendingChanges();
+
   RecordP3A(log_.size() - unsent_entries_.size());
 
   // Rebuild the unsent set.
@@ -137,13 +134,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
   auto log_iter = log_.find(staged_entry_key_);
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  SchedulePersist(log_iter->first);
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -154,6 +145,38 @@ void BraveP3ALogStore::DiscardStagedLog() {
   staged_log_.clear();
 }
 
+void BraveP3ALogStore::PersistPendingChanges() {
+  persist_timer_.Stop();
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  // A single update for all entries, so that the dictionary pref is only
+  // compared and written once.
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& histogram_name : dirty_entries_) {
+    auto log_iter = log_.find(histogram_name);
+    if (log_iter == log_.end()) {
+      continue;
+    }
+    const LogEntry& entry = log_iter->second;
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({histogram_name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  dirty_entries_.clear();
+}
+
+void BraveP3ALogStore::SchedulePersist(const std::string& histogram_name) {
+  dirty_entries_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, kPersistDelay, this,
+                         &BraveP3ALogStore::PersistPendingChanges);
+  }
+}
+
 void BraveP3ALogStore::PersistUnsentLogs() const {
   NOTREACHED();
 }
@@ -12,6 +12,7 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,7 +20,8 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs shortly after
+// they change, coalescing several changes into a single pref update.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -46,6 +48,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   void UpdateValue(const std::string& histogram_name, uint64_t value);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
+  // Writes all pending changes to local state right away.
+  void PersistPendingChanges();
 
   // metrics::LogStore:
   bool has_unsent_logs() const override;
@@ -57,7 +61,7 @@ class BraveP3ALogStore : public metrics::LogStore {
   void DiscardStagedLog() override;
 
   // |PersistUnsentLogs| should not be used, since we persist everything
-  // on the fly.
+  // on the fly (see |PersistPendingChanges()|).
   void PersistUnsentLogs() const override;
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
@@ -80,6 +84,8 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void SchedulePersist(const std::string& histogram_name);
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -87,6 +93,10 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
+  // Entries changed since the last write to local state.
+  base::flat_set<std::string> dirty_entries_;
+  base::OneShotTimer persist_timer_;
+
   std::string staged_entry_key_;
   std::string staged_log_;
 
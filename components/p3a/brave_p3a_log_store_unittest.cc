@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kHistogramName[] = "Brave.P3A.Test";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public ::testing::Test {
+ public:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = CreateLogStore();
+  }
+
+ protected:
+  std::unique_ptr<BraveP3ALogStore> CreateLogStore() {
+    auto log_store =
+        std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store->LoadPersistedUnsentLogs();
+    return log_store;
+  }
+
+  bool IsPersisted() {
+    return local_state_.GetDictionary("p3a.logs")->HasKey(kHistogramName);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestDelegate delegate_;
+  TestingPrefServiceSimple local_state_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+};
+
+TEST_F(BraveP3ALogStoreTest, PersistPendingChangesBeforeDelay) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  EXPECT_FALSE(IsPersisted());
+
+  log_store_->PersistPendingChanges();
+  EXPECT_TRUE(IsPersisted());
+}
+
+TEST_F(BraveP3ALogStoreTest, SentMarkSurvivesShutdown) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+
+  // What the service does on browser shutdown, before the delay elapses.
+  log_store_->PersistPendingChanges();
+  log_store_.reset();
+
+  // The already sent value is not sent again on the next run.
+  log_store_ = CreateLogStore();
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+}
+
+}  // namespace brave
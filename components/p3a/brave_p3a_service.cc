@@ -184,6 +184,12 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::Shutdown() {
+  if (log_store_) {
+    log_store_->PersistPendingChanges();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) const {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -312,16 +318,38 @@ void BraveP3AService::OnHistogramChanged(base::StringPiece histogram_name,
     return;
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  bool should_post_task = false;
+  {
+    base::AutoLock lock(pending_histograms_lock_);
+    should_post_task = pending_histogram_buckets_.empty();
+    pending_histogram_buckets_[histogram_name] = bucket;
+  }
+
+  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+
+  if (should_post_task) {
+    base::PostTask(
+        FROM_HERE, {content::BrowserThread::UI},
+        base::BindOnce(&BraveP3AService::OnPendingHistogramsChangedOnUI,
+                       this));
+  }
+}
+
+void BraveP3AService::OnPendingHistogramsChangedOnUI() {
+  base::flat_map<base::StringPiece, size_t> buckets;
+  {
+    base::AutoLock lock(pending_histograms_lock_);
+    buckets.swap(pending_histogram_buckets_);
+  }
+
+  for (const auto& entry : buckets) {
+    OnHistogramChangedOnUI(entry.first, entry.second);
+  }
 }
 
 void BraveP3AService::OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                                             base::HistogramBase::Sample sample,
                                              size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
   if (!initialized_) {
     histogram_values_[histogram_name] = bucket;
   } else {
@@ -12,6 +12,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -47,6 +48,11 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes pending log changes to local state. Should be called on browser
+  // shutdown before local state is committed, otherwise already sent values
+  // would be sent again on the next run.
+  void Shutdown();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) const override;
@@ -65,11 +71,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   // Invoked by callbacks registered by our service. Since these callbacks
   // can fire on any thread, this method reposts everything to UI thread.
+  // Samples recorded before the posted task runs are coalesced, so only the
+  // latest bucket of each histogram is handled.
   void OnHistogramChanged(base::StringPiece histogram_name,
                           base::HistogramBase::Sample sample);
 
+  void OnPendingHistogramsChangedOnUI();
+
   void OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                              base::HistogramBase::Sample sample,
                               size_t bucket);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
@@ -101,6 +110,11 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Buckets of histograms that changed since the last task posted to the UI
+  // thread. Guarded by |pending_histograms_lock_|.
+  base::Lock pending_histograms_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_histogram_buckets_;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
@@ -59,6 +59,8 @@ class BatAdsImpl :
   void OnForeground() override;
   void OnBackground() override;
 
+  void FlushState() override;
+
   void OnMediaPlaying(
       const int32_t tab_id) override;
   void OnMediaStopped(
@@ -27,6 +27,12 @@ void OnLoadState(const ledger::OnLoadCallback& callback,
   callback(result, value);
 }
 
+void OnLoadBinaryState(const ledger::OnLoadBinaryStateCallback& callback,
+                       const ledger::Result result,
+                       const std::vector<uint8_t>& value) {
+  callback(result, value);
+}
+
 }  // namespace
 
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
@@ -239,6 +245,32 @@ void BatLedgerClientMojoBridge::ResetState(
       name, base::BindOnce(&OnResultCallback, std::move(callback)));
 }
 
+void BatLedgerClientMojoBridge::SaveBinaryState(
+    const std::string& name,
+    const std::vector<uint8_t>& value,
+    ledger::ResultCallback callback) {
+  if (!Connected()) {
+    callback(ledger::Result::LEDGER_ERROR);
+    return;
+  }
+
+  bat_ledger_client_->SaveBinaryState(
+      name, value,
+      base::BindOnce(&OnResultCallback, std::move(callback)));
+}
+
+void BatLedgerClientMojoBridge::LoadBinaryState(
+    const std::string& name,
+    ledger::OnLoadBinaryStateCallback callback) {
+  if (!Connected()) {
+    callback(ledger::Result::LEDGER_ERROR, std::vector<uint8_t>());
+    return;
+  }
+
+  bat_ledger_client_->LoadBinaryState(
+      name, base::BindOnce(&OnLoadBinaryState, std::move(callback)));
+}
+
 void BatLedgerClientMojoBridge::SetBooleanState(const std::string& name,
                                                bool value) {
   bat_ledger_client_->SetBooleanState(name, value);
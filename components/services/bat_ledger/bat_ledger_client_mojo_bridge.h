@@ -70,6 +70,11 @@ class BatLedgerClientMojoBridge :
                  ledger::OnLoadCallback callback) override;
   void ResetState(const std::string& name,
                   ledger::ResultCallback callback) override;
+  void SaveBinaryState(const std::string& name,
+                       const std::vector<uint8_t>& value,
+                       ledger::ResultCallback callback) override;
+  void LoadBinaryState(const std::string& name,
+                       ledger::OnLoadBinaryStateCallback callback) override;
   void SetBooleanState(const std::string& name, bool value) override;
   bool GetBooleanState(const std::string& name) const override;
   void SetIntegerState(const std::string& name, int value) override;
@@ -235,6 +235,52 @@ void LedgerClientMojoBridge::ResetState(
       std::bind(LedgerClientMojoBridge::OnResetState, holder, _1));
 }
 
+// static
+void LedgerClientMojoBridge::OnSaveBinaryState(
+    CallbackHolder<SaveBinaryStateCallback>* holder,
+    const ledger::Result result) {
+  DCHECK(holder);
+  if (holder->is_valid())
+    std::move(holder->get()).Run(result);
+  delete holder;
+}
+
+void LedgerClientMojoBridge::SaveBinaryState(
+    const std::string& name,
+    const std::vector<uint8_t>& value,
+    SaveBinaryStateCallback callback) {
+  // deleted in OnSaveBinaryState
+  auto* holder = new CallbackHolder<SaveBinaryStateCallback>(
+      AsWeakPtr(), std::move(callback));
+
+  ledger_client_->SaveBinaryState(
+      name, value,
+      std::bind(LedgerClientMojoBridge::OnSaveBinaryState, holder, _1));
+}
+
+// static
+void LedgerClientMojoBridge::OnLoadBinaryState(
+    CallbackHolder<LoadBinaryStateCallback>* holder,
+    const ledger::Result result,
+    const std::vector<uint8_t>& value) {
+  DCHECK(holder);
+  if (holder->is_valid())
+    std::move(holder->get()).Run(result, value);
+  delete holder;
+}
+
+void LedgerClientMojoBridge::LoadBinaryState(
+    const std::string& name,
+    LoadBinaryStateCallback callback) {
+  // deleted in OnLoadBinaryState
+  auto* holder = new CallbackHolder<LoadBinaryStateCallback>(
+      AsWeakPtr(), std::move(callback));
+
+  ledger_client_->LoadBinaryState(
+      name, std::bind(LedgerClientMojoBridge::OnLoadBinaryState, holder,
+                      _1, _2));
+}
+
 void LedgerClientMojoBridge::SetBooleanState(const std::string& name,
                                             bool value) {
   ledger_client_->SetBooleanState(name, value);
@@ -68,6 +68,13 @@ class LedgerClientMojoBridge :
   void ResetState(
       const std::string& name,
       ResetStateCallback callback) override;
+  void SaveBinaryState(
+      const std::string& name,
+      const std::vector<uint8_t>& value,
+      SaveBinaryStateCallback callback) override;
+  void LoadBinaryState(
+      const std::string& name,
+      LoadBinaryStateCallback callback) override;
   void SetBooleanState(const std::string& name, bool value) override;
   void GetBooleanState(const std::string& name,
                        GetBooleanStateCallback callback) override;
@@ -218,6 +225,15 @@ class LedgerClientMojoBridge :
       CallbackHolder<ResetStateCallback>* holder,
       ledger::Result result);
 
+  static void OnSaveBinaryState(
+      CallbackHolder<SaveBinaryStateCallback>* holder,
+      ledger::Result result);
+
+  static void OnLoadBinaryState(
+      CallbackHolder<LoadBinaryStateCallback>* holder,
+      ledger::Result result,
+      const std::vector<uint8_t>& value);
+
   static void OnShowNotification(
     CallbackHolder<ShowNotificationCallback>* holder,
     const ledger::Result result);
@@ -15,7 +15,7 @@ namespace speedreader {
 class SpeedreaderWhitelist;
 
 // Launches the speedreader distillation pass over a reponce body, deferring
-// the load until distillation is done.
+// the load until it's known whether the page is distilled.
 // TODO(iefremov): Avoid distilling the same page twice (see comments in
 // blink::URLLoaderThrottle)?
 // TODO(iefremov): Check throttles order?
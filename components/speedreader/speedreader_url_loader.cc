@@ -12,11 +12,13 @@
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "brave/components/speedreader/speedreader_whitelist.h"
 #include "components/grit/brave_components_resources.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "net/base/net_errors.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "ui/base/resource/resource_bundle.h"
 
@@ -25,6 +27,14 @@ namespace speedreader {
 namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
+// Reading from the source is paused while this much data waits to be sent.
+constexpr size_t kMaxSendBufferSize = 8 * kReadBufferSize;
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinDistilledBodySize = 1024;
+
+SpeedReaderURLLoader::RewriterFactory* g_rewriter_factory_for_testing =
+    nullptr;
 
 std::string GetDistilledPageResources() {
   return "<style id=\"brave_speedreader_style\">" +
@@ -33,8 +43,103 @@ std::string GetDistilledPageResources() {
          "</style>";
 }
 
+class WhitelistBodyRewriter : public SpeedReaderURLLoader::BodyRewriter {
+ public:
+  explicit WhitelistBodyRewriter(std::unique_ptr<Rewriter> rewriter)
+      : rewriter_(std::move(rewriter)) {}
+  ~WhitelistBodyRewriter() override = default;
+
+  int Write(const char* chunk, size_t chunk_len) override {
+    return rewriter_->Write(chunk, chunk_len);
+  }
+  int End() override { return rewriter_->End(); }
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+};
+
 }  // namespace
 
+// Owns a Rewriter on a background sequence, so that distilling doesn't block
+// the loader. Every call is made on that sequence; results are posted back to
+// the loader's task runner in order.
+class RewriterHost {
+ public:
+  using OutputCallback = base::RepeatingCallback<void(std::string)>;
+  using EndedCallback = base::OnceCallback<void(bool)>;
+
+  RewriterHost(scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+               OutputCallback output_callback,
+               base::OnceClosure error_callback)
+      : reply_task_runner_(std::move(reply_task_runner)),
+        output_callback_(std::move(output_callback)),
+        error_callback_(std::move(error_callback)) {}
+  ~RewriterHost() = default;
+
+  RewriterHost(const RewriterHost&) = delete;
+  RewriterHost& operator=(const RewriterHost&) = delete;
+
+  // Must be called before any Write(), on the loader's sequence.
+  void set_rewriter(
+      std::unique_ptr<SpeedReaderURLLoader::BodyRewriter> rewriter) {
+    rewriter_ = std::move(rewriter);
+  }
+
+  static void OnOutput(const char* chunk, size_t chunk_len, void* user_data) {
+    static_cast<RewriterHost*>(user_data)->output_.append(chunk, chunk_len);
+  }
+
+  void Write(std::string chunk) {
+    if (failed_)
+      return;
+    base::ElapsedTimer timer;
+    if (rewriter_->Write(chunk.data(), chunk.size()) != 0) {
+      failed_ = true;
+      reply_task_runner_->PostTask(FROM_HERE, std::move(error_callback_));
+      return;
+    }
+    distill_time_ += timer.Elapsed();
+    FlushOutput();
+  }
+
+  void End(EndedCallback callback) {
+    bool success = false;
+    if (!failed_) {
+      base::ElapsedTimer timer;
+      success = rewriter_->End() == 0;
+      distill_time_ += timer.Elapsed();
+      UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", distill_time_);
+      FlushOutput();
+    }
+    reply_task_runner_->PostTask(FROM_HERE,
+                                 base::BindOnce(std::move(callback), success));
+  }
+
+ private:
+  void FlushOutput() {
+    if (output_.empty())
+      return;
+    reply_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(output_callback_, std::move(output_)));
+    output_.clear();
+  }
+
+  scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner_;
+  OutputCallback output_callback_;
+  base::OnceClosure error_callback_;
+  std::unique_ptr<SpeedReaderURLLoader::BodyRewriter> rewriter_;
+  // Output produced by the current call, sent back as one chunk.
+  std::string output_;
+  base::TimeDelta distill_time_;
+  bool failed_ = false;
+};
+
+// static
+void SpeedReaderURLLoader::SetRewriterFactoryForTesting(
+    RewriterFactory* factory) {
+  g_rewriter_factory_for_testing = factory;
+}
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -127,6 +232,37 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  if (!whitelist_ && !g_rewriter_factory_for_testing) {
+    Abort();
+    return;
+  }
+
+  // The rewriter keeps the document being distilled, so it gets a sequence of
+  // its own and all chunks are written to it in order.
+  rewriter_task_runner_ = base::CreateSequencedTaskRunner(
+      {base::ThreadPool(), base::TaskPriority::USER_BLOCKING});
+  rewriter_host_ = std::unique_ptr<RewriterHost, base::OnTaskRunnerDeleter>(
+      new RewriterHost(
+          task_runner_,
+          base::BindRepeating(&SpeedReaderURLLoader::OnRewriterOutput,
+                              weak_factory_.GetWeakPtr()),
+          base::BindOnce(&SpeedReaderURLLoader::OnRewriterError,
+                         weak_factory_.GetWeakPtr())),
+      base::OnTaskRunnerDeleter(rewriter_task_runner_));
+  if (g_rewriter_factory_for_testing) {
+    is_streaming_rewriter_ = true;
+    rewriter_host_->set_rewriter(g_rewriter_factory_for_testing->Run(
+        &RewriterHost::OnOutput, rewriter_host_.get()));
+  } else {
+    const RewriterType rewriter_type =
+        whitelist_->GetRewriterType(response_url_);
+    is_streaming_rewriter_ = rewriter_type == RewriterType::RewriterStreaming;
+    rewriter_host_->set_rewriter(std::make_unique<WhitelistBodyRewriter>(
+        whitelist_->MakeRewriter(response_url_, rewriter_type,
+                                 &RewriterHost::OnOutput,
+                                 rewriter_host_.get())));
+  }
+
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -197,20 +333,23 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
-  DCHECK_EQ(State::kLoading, state_);
+  DCHECK(state_ == State::kLoading || state_ == State::kSending);
+  if (IsSendBufferFull()) {
+    // Resumed by SendBufferedBodyToClient() once the destination catches up.
+    body_read_paused_ = true;
+    return;
+  }
 
-  size_t start_size = buffered_body_.size();
+  std::string chunk(kReadBufferSize, '\0');
   uint32_t read_bytes = kReadBufferSize;
-  buffered_body_.resize(start_size + read_bytes);
   MojoResult result = body_consumer_handle_->ReadData(
-      &buffered_body_[0] + start_size, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
-      buffered_body_.resize(start_size);
-      MaybeLaunchSpeedreader();
+      OnBodyReadFinished();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
       body_consumer_watcher_.ArmOrNotify();
@@ -221,78 +360,144 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   }
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
-  buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  chunk.resize(read_bytes);
 
-  body_consumer_watcher_.ArmOrNotify();
-}
+  if (state_ == State::kLoading) {
+    buffered_body_.append(chunk);
+  } else if (!send_distilled_) {
+    AppendToSendBuffer(chunk.data(), chunk.size());
+  }
 
-void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
-  DCHECK_EQ(State::kSending, state_);
-  if (bytes_remaining_in_buffer_ > 0) {
-    SendReceivedBodyToClient();
-  } else {
-    CompleteSending();
+  if (rewriter_host_) {
+    rewriter_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&RewriterHost::Write,
+                                  base::Unretained(rewriter_host_.get()),
+                                  std::move(chunk)));
   }
+
+  if (state_ == State::kLoading || state_ == State::kSending)
+    body_consumer_watcher_.ArmOrNotify();
 }
 
-void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
-  DCHECK_EQ(State::kLoading, state_);
-  if (!throttle_ || !whitelist_) {
-    Abort();
+void SpeedReaderURLLoader::OnBodyReadFinished() {
+  VLOG(2) << __func__ << " body size = " << buffered_body_.size();
+  body_read_finished_ = true;
+  body_consumer_watcher_.Cancel();
+
+  if (!rewriter_host_) {
+    // Nothing is distilled, so the whole body is already buffered for
+    // sending.
+    if (state_ == State::kLoading)
+      StartSending(false /* distilled */);
+    else
+      MaybeCompleteSending();
     return;
   }
 
-  VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
-  bytes_remaining_in_buffer_ = buffered_body_.size();
-
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
-    base::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return GetDistilledPageResources() + transformed;
-            },
-            std::move(buffered_body_), whitelist_->MakeRewriter(response_url_)),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
-                       weak_factory_.GetWeakPtr()));
-    return;
+  rewriter_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&RewriterHost::End, base::Unretained(rewriter_host_.get()),
+                     base::BindOnce(&SpeedReaderURLLoader::OnRewriterEnded,
+                                    weak_factory_.GetWeakPtr())));
+}
+
+void SpeedReaderURLLoader::OnRewriterOutput(std::string output) {
+  switch (state_) {
+    case State::kLoading:
+      distilled_body_.append(output);
+      // A streaming rewriter only emits the content it found, so once there
+      // is enough of it the page is distilled and can be sent progressively.
+      if (is_streaming_rewriter_ &&
+          distilled_body_.size() >= kMinDistilledBodySize) {
+        StartSending(true /* distilled */);
+      }
+      return;
+    case State::kSending:
+      if (send_distilled_)
+        AppendToSendBuffer(output.data(), output.size());
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+    case State::kAborted:
+      return;
   }
-  CompleteLoading(std::move(buffered_body_));
+  NOTREACHED();
 }
 
-void SpeedReaderURLLoader::CompleteLoading(std::string body) {
+void SpeedReaderURLLoader::OnRewriterError() {
+  VLOG(2) << __func__ << " " << response_url_;
+  rewriter_host_.reset();
+  rewriter_finished_ = true;
+  switch (state_) {
+    case State::kLoading:
+      // Fall back to the original page.
+      StartSending(false /* distilled */);
+      return;
+    case State::kSending:
+      // The original page is being sent, the rewriter isn't needed anymore.
+      if (!send_distilled_)
+        return;
+      // Part of the distilled page has already been sent and the rest of it
+      // can't be produced. Stop reading the body and end the response with an
+      // error once the sent part is flushed, so the destination doesn't take
+      // a truncated page for a complete one.
+      body_consumer_watcher_.Cancel();
+      body_consumer_handle_.reset();
+      body_read_finished_ = true;
+      body_read_paused_ = false;
+      source_url_loader_.reset();
+      source_url_client_receiver_.reset();
+      complete_status_ = network::URLLoaderCompletionStatus(net::ERR_FAILED);
+      MaybeCompleteSending();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+    case State::kAborted:
+      return;
+  }
+  NOTREACHED();
+}
+
+void SpeedReaderURLLoader::OnRewriterEnded(bool success) {
+  rewriter_host_.reset();
+  rewriter_finished_ = true;
+  switch (state_) {
+    case State::kLoading:
+      StartSending(success && distilled_body_.size() >= kMinDistilledBodySize);
+      return;
+    case State::kSending:
+      MaybeCompleteSending();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+    case State::kAborted:
+      return;
+  }
+  NOTREACHED();
+}
+
+void SpeedReaderURLLoader::StartSending(bool distilled) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
+  send_distilled_ = distilled;
 
   if (!throttle_) {
     Abort();
     return;
   }
 
-  buffered_body_ = std::move(body);
-  bytes_remaining_in_buffer_ = buffered_body_.size();
+  if (send_distilled_) {
+    send_buffer_ = GetDistilledPageResources() + distilled_body_;
+  } else {
+    send_buffer_ = std::move(buffered_body_);
+    // The rewriter output won't be used.
+    rewriter_host_.reset();
+    rewriter_finished_ = true;
+  }
+  // Release the memory of whichever body isn't sent.
+  std::string().swap(buffered_body_);
+  std::string().swap(distilled_body_);
+  send_buffer_offset_ = 0;
 
   throttle_->Resume();
   mojo::ScopedDataPipeConsumerHandle body_to_send;
@@ -313,38 +518,34 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
 
-  DCHECK(bytes_remaining_in_buffer_);
-  if (bytes_remaining_in_buffer_) {
-    SendReceivedBodyToClient();
-    return;
-  }
-
-  CompleteSending();
+  SendBufferedBodyToClient();
 }
 
-void SpeedReaderURLLoader::CompleteSending() {
+void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
-  state_ = State::kCompleted;
-  // Call client's OnComplete() if |this|'s OnComplete() has already been
-  // called.
-  if (complete_status_.has_value())
-    destination_url_loader_client_->OnComplete(complete_status_.value());
+  SendBufferedBodyToClient();
+}
 
-  body_consumer_watcher_.Cancel();
-  body_producer_watcher_.Cancel();
-  body_consumer_handle_.reset();
-  body_producer_handle_.reset();
+void SpeedReaderURLLoader::AppendToSendBuffer(const char* data, size_t size) {
+  DCHECK_EQ(State::kSending, state_);
+  const bool was_empty = send_buffer_offset_ == send_buffer_.size();
+  send_buffer_.append(data, size);
+  // Otherwise a write is already pending on |body_producer_watcher_|.
+  if (was_empty)
+    SendBufferedBodyToClient();
 }
 
-void SpeedReaderURLLoader::SendReceivedBodyToClient() {
+void SpeedReaderURLLoader::SendBufferedBodyToClient() {
   DCHECK_EQ(State::kSending, state_);
-  // Send the buffered data first.
-  DCHECK_GT(bytes_remaining_in_buffer_, 0u);
-  size_t start_position = buffered_body_.size() - bytes_remaining_in_buffer_;
-  uint32_t bytes_sent = bytes_remaining_in_buffer_;
-  MojoResult result =
-      body_producer_handle_->WriteData(buffered_body_.data() + start_position,
-                                       &bytes_sent, MOJO_WRITE_DATA_FLAG_NONE);
+  if (send_buffer_offset_ == send_buffer_.size()) {
+    MaybeCompleteSending();
+    return;
+  }
+
+  uint32_t bytes_sent = send_buffer_.size() - send_buffer_offset_;
+  MojoResult result = body_producer_handle_->WriteData(
+      send_buffer_.data() + send_buffer_offset_, &bytes_sent,
+      MOJO_WRITE_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
@@ -360,13 +561,57 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       NOTREACHED();
       return;
   }
-  bytes_remaining_in_buffer_ -= bytes_sent;
-  body_producer_watcher_.ArmOrNotify();
+
+  send_buffer_offset_ += bytes_sent;
+  if (send_buffer_offset_ == send_buffer_.size()) {
+    send_buffer_.clear();
+    send_buffer_offset_ = 0;
+  }
+
+  if (body_read_paused_ && !IsSendBufferFull()) {
+    body_read_paused_ = false;
+    body_consumer_watcher_.ArmOrNotify();
+  }
+
+  if (send_buffer_offset_ < send_buffer_.size())
+    body_producer_watcher_.ArmOrNotify();
+  else
+    MaybeCompleteSending();
+}
+
+bool SpeedReaderURLLoader::IsSendBufferFull() const {
+  return state_ == State::kSending &&
+         send_buffer_.size() - send_buffer_offset_ >= kMaxSendBufferSize;
+}
+
+void SpeedReaderURLLoader::MaybeCompleteSending() {
+  DCHECK_EQ(State::kSending, state_);
+  if (!body_read_finished_ || !rewriter_finished_ ||
+      send_buffer_offset_ < send_buffer_.size()) {
+    return;
+  }
+  CompleteSending();
+}
+
+void SpeedReaderURLLoader::CompleteSending() {
+  DCHECK_EQ(State::kSending, state_);
+  state_ = State::kCompleted;
+  // Call client's OnComplete() if |this|'s OnComplete() has already been
+  // called.
+  if (complete_status_.has_value())
+    destination_url_loader_client_->OnComplete(complete_status_.value());
+
+  body_consumer_watcher_.Cancel();
+  body_producer_watcher_.Cancel();
+  body_consumer_handle_.reset();
+  body_producer_handle_.reset();
+  rewriter_host_.reset();
 }
 
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
+  rewriter_host_.reset();
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
   source_url_loader_.reset();
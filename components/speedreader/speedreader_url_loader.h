@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -27,10 +29,12 @@
 
 namespace speedreader {
 
+class RewriterHost;
 class SpeedReaderThrottle;
 class SpeedreaderWhitelist;
 
-// Loads the whole response body and tries to Speedreader-distill it.
+// Passes the response body through Speedreader as it arrives and sends the
+// distilled page, or the original one if it can't be distilled.
 // Cargoculted from |`SniffingURLLoader|.
 //
 // This loader has five states:
@@ -39,18 +43,24 @@ class SpeedreaderWhitelist;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
-//            done, this loader will dispatch queued messages like
-//            OnStartLoadingResponseBody() to the destination
-//            loader client, and then the state is changed to kSending.
-// kSending: Receives the body and sends it to the destination loader client.
-//           The state changes to kCompleted after all data is sent.
+// kLoading: Receives the body from the source loader and writes every chunk
+//           to the rewriter on a background sequence. The original body is
+//           kept in this loader until it's known whether the page is
+//           distilled: a streaming rewriter decides as soon as it has produced
+//           enough output, other rewriters once the whole body is written.
+//           Then this loader dispatches OnStartLoadingResponseBody() to the
+//           destination loader client and the state is changed to kSending.
+// kSending: Keeps receiving the body. Output of the rewriter, or the original
+//           body if the page isn't distilled, is sent to the destination
+//           loader client as it becomes available. The state changes to
+//           kCompleted after all data is sent. If the rewriter fails after the
+//           distilled page is started, reading stops and the response is
+//           completed with an error.
 // kCompleted: All data has been sent to the destination loader.
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
 //           the destination (through network::mojom::URLLoader) are ignored in
+//           this state.
 class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                              public network::mojom::URLLoader {
  public:
@@ -59,6 +69,24 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   SpeedReaderURLLoader(const SpeedReaderURLLoader&) = delete;
   SpeedReaderURLLoader& operator=(const SpeedReaderURLLoader&) = delete;
 
+  // The part of |Rewriter| the body is written to, so that tests can replace
+  // the rewriter made from the whitelist. Both methods return 0 on success.
+  class BodyRewriter {
+   public:
+    virtual ~BodyRewriter() = default;
+    virtual int Write(const char* chunk, size_t chunk_len) = 0;
+    virtual int End() = 0;
+  };
+
+  using RewriterFactory =
+      base::RepeatingCallback<std::unique_ptr<BodyRewriter>(
+          void (*output_sink)(const char*, size_t, void*),
+          void* output_sink_user_data)>;
+
+  // Makes loaders distill every page with streaming rewriters from |factory|
+  // instead of the whitelist. Pass nullptr to reset.
+  static void SetRewriterFactoryForTesting(RewriterFactory* factory);
+
   // Start waiting for the body.
   void Start(
       mojo::PendingRemote<network::mojom::URLLoader> source_url_loader_remote,
@@ -113,12 +141,21 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
-  void MaybeLaunchSpeedreader();
-
-  // Gets either distilled or untouched body.
-  void CompleteLoading(std::string body);
+  void OnBodyReadFinished();
+
+  // Called with the results of |rewriter_host_|.
+  void OnRewriterOutput(std::string output);
+  void OnRewriterError();
+  void OnRewriterEnded(bool success);
+
+  // Starts sending the body to the destination, either the distilled page or
+  // the original one.
+  void StartSending(bool distilled);
+  void AppendToSendBuffer(const char* data, size_t size);
+  void SendBufferedBodyToClient();
+  bool IsSendBufferFull() const;
+  void MaybeCompleteSending();
   void CompleteSending();
-  void SendReceivedBodyToClient();
 
   void Abort();
 
@@ -139,9 +176,26 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   // Set if OnComplete() is called during distilling.
   base::Optional<network::URLLoaderCompletionStatus> complete_status_;
 
-  // Note that this could be replaced by a distilled version.
+  // Lives on |rewriter_task_runner_|. Reset once its output isn't needed.
+  std::unique_ptr<RewriterHost, base::OnTaskRunnerDeleter> rewriter_host_{
+      nullptr, base::OnTaskRunnerDeleter(nullptr)};
+  scoped_refptr<base::SequencedTaskRunner> rewriter_task_runner_;
+  bool is_streaming_rewriter_ = false;
+  bool rewriter_finished_ = false;
+
+  // Original body, kept in kLoading in case the page isn't distilled.
   std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  // Rewriter output received in kLoading.
+  std::string distilled_body_;
+  bool body_read_finished_ = false;
+  // Set in kSending when reading from the source is paused because the
+  // destination doesn't keep up.
+  bool body_read_paused_ = false;
+
+  // Set in kSending.
+  bool send_distilled_ = false;
+  std::string send_buffer_;
+  size_t send_buffer_offset_ = 0;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
@@ -0,0 +1,351 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_url_loader.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/optional.h"
+#include "base/run_loop.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "brave/components/speedreader/speedreader_throttle.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_utils.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kResponseURL[] = "https://example.com/article/";
+constexpr char kDistilledPagePrefix[] = "<style id=\"brave_speedreader_style\">";
+
+// Passes every chunk written to it through as its output. The write numbered
+// |fail_on_write| fails, and End() waits for |end_event| if it's given.
+class EchoRewriter : public SpeedReaderURLLoader::BodyRewriter {
+ public:
+  EchoRewriter(void (*output_sink)(const char*, size_t, void*),
+               void* output_sink_user_data,
+               int fail_on_write,
+               base::WaitableEvent* end_event)
+      : output_sink_(output_sink),
+        output_sink_user_data_(output_sink_user_data),
+        fail_on_write_(fail_on_write),
+        end_event_(end_event) {}
+  ~EchoRewriter() override = default;
+
+  int Write(const char* chunk, size_t chunk_len) override {
+    if (writes_++ == fail_on_write_)
+      return 1;
+    output_sink_(chunk, chunk_len, output_sink_user_data_);
+    return 0;
+  }
+
+  int End() override {
+    if (end_event_) {
+      base::ScopedAllowBaseSyncPrimitivesForTesting allow_wait;
+      end_event_->Wait();
+    }
+    return 0;
+  }
+
+ private:
+  void (*output_sink_)(const char*, size_t, void*);
+  void* output_sink_user_data_;
+  const int fail_on_write_;
+  base::WaitableEvent* end_event_;
+  int writes_ = 0;
+};
+
+// Stands for the renderer the response is passed to.
+class DestinationClient : public network::mojom::URLLoaderClient {
+ public:
+  explicit DestinationClient(
+      mojo::PendingReceiver<network::mojom::URLLoaderClient> receiver)
+      : receiver_(this, std::move(receiver)) {
+    receiver_.set_disconnect_handler(base::BindOnce(
+        &DestinationClient::OnDisconnect, base::Unretained(this)));
+  }
+
+  DestinationClient(const DestinationClient&) = delete;
+  DestinationClient& operator=(const DestinationClient&) = delete;
+
+  void WaitForBody() {
+    while (!body_.is_valid() && !disconnected_)
+      Wait();
+  }
+
+  void WaitForCompletion() {
+    while (!status_ && !disconnected_)
+      Wait();
+  }
+
+  void WaitForDisconnect() {
+    while (!disconnected_)
+      Wait();
+  }
+
+  // Must be called after the response is completed.
+  std::string ReadBody() {
+    std::string body;
+    EXPECT_TRUE(mojo::BlockingCopyToString(std::move(body_), &body));
+    return body;
+  }
+
+  void DropBody() { body_.reset(); }
+
+  const base::Optional<network::URLLoaderCompletionStatus>& status() const {
+    return status_;
+  }
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override {}
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {}
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback ack_callback) override {}
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override {}
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {}
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override {
+    body_ = std::move(body);
+    Quit();
+  }
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    status_ = status;
+    Quit();
+  }
+
+ private:
+  void OnDisconnect() {
+    disconnected_ = true;
+    Quit();
+  }
+
+  void Wait() {
+    base::RunLoop run_loop;
+    quit_closure_ = run_loop.QuitClosure();
+    run_loop.Run();
+  }
+
+  void Quit() {
+    if (quit_closure_)
+      std::move(quit_closure_).Run();
+  }
+
+  mojo::Receiver<network::mojom::URLLoaderClient> receiver_;
+  mojo::ScopedDataPipeConsumerHandle body_;
+  base::Optional<network::URLLoaderCompletionStatus> status_;
+  bool disconnected_ = false;
+  base::OnceClosure quit_closure_;
+};
+
+}  // namespace
+
+class SpeedReaderURLLoaderTest : public ::testing::Test,
+                                 public blink::URLLoaderThrottle::Delegate {
+ public:
+  SpeedReaderURLLoaderTest()
+      : rewriter_factory_(
+            base::BindRepeating(&SpeedReaderURLLoaderTest::MakeRewriter,
+                                base::Unretained(this))) {}
+
+  void SetUp() override {
+    SpeedReaderURLLoader::SetRewriterFactoryForTesting(&rewriter_factory_);
+  }
+
+  void TearDown() override {
+    // Don't leave a rewriter blocked if a test has failed early.
+    rewriter_end_event_.Signal();
+    SpeedReaderURLLoader::SetRewriterFactoryForTesting(nullptr);
+  }
+
+  // blink::URLLoaderThrottle::Delegate:
+  void CancelWithError(int error_code,
+                       base::StringPiece custom_reason) override {
+    ADD_FAILURE() << "Unexpected cancel: " << error_code;
+  }
+
+  void Resume() override { resumed_ = true; }
+
+  void InterceptResponse(
+      mojo::PendingRemote<network::mojom::URLLoader> new_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>
+          new_client_receiver,
+      mojo::PendingRemote<network::mojom::URLLoader>* original_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>*
+          original_client_receiver) override {
+    loader_.Bind(std::move(new_loader));
+    destination_ =
+        std::make_unique<DestinationClient>(std::move(new_client_receiver));
+    source_loader_receiver_ = original_loader->InitWithNewPipeAndPassReceiver();
+    *original_client_receiver = source_client_.BindNewPipeAndPassReceiver();
+  }
+
+ protected:
+  std::unique_ptr<SpeedReaderURLLoader::BodyRewriter> MakeRewriter(
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data) {
+    return std::make_unique<EchoRewriter>(
+        output_sink, output_sink_user_data, fail_on_write_,
+        block_rewriter_end_ ? &rewriter_end_event_ : nullptr);
+  }
+
+  // Intercepts the response and starts passing the body to the loader.
+  void StartLoading() {
+    throttle_ = std::make_unique<SpeedReaderThrottle>(
+        nullptr, base::ThreadTaskRunnerHandle::Get());
+    throttle_->set_delegate(this);
+    auto response_head = network::mojom::URLResponseHead::New();
+    bool defer = false;
+    throttle_->WillProcessResponse(GURL(kResponseURL), response_head.get(),
+                                   &defer);
+    EXPECT_TRUE(defer);
+
+    mojo::ScopedDataPipeConsumerHandle body;
+    ASSERT_EQ(MOJO_RESULT_OK,
+              mojo::CreateDataPipe(nullptr, &body_producer_, &body));
+    source_client_->OnStartLoadingResponseBody(std::move(body));
+  }
+
+  void WriteBody(const std::string& chunk) {
+    uint32_t size = chunk.size();
+    ASSERT_EQ(MOJO_RESULT_OK,
+              body_producer_->WriteData(chunk.data(), &size,
+                                        MOJO_WRITE_DATA_FLAG_ALL_OR_NONE));
+  }
+
+  void FinishBody() {
+    body_producer_.reset();
+    source_client_->OnComplete(network::URLLoaderCompletionStatus(net::OK));
+  }
+
+  bool IsSourceConnected() {
+    source_client_.FlushForTesting();
+    return source_client_.is_connected();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  SpeedReaderURLLoader::RewriterFactory rewriter_factory_;
+  int fail_on_write_ = -1;
+  bool block_rewriter_end_ = false;
+  base::WaitableEvent rewriter_end_event_;
+  bool resumed_ = false;
+
+  std::unique_ptr<SpeedReaderThrottle> throttle_;
+  mojo::Remote<network::mojom::URLLoader> loader_;
+  std::unique_ptr<DestinationClient> destination_;
+  mojo::PendingReceiver<network::mojom::URLLoader> source_loader_receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> source_client_;
+  mojo::ScopedDataPipeProducerHandle body_producer_;
+};
+
+TEST_F(SpeedReaderURLLoaderTest, StreamsDistilledPage) {
+  const std::string first_chunk(2048, 'a');
+  const std::string second_chunk(2048, 'b');
+  StartLoading();
+
+  WriteBody(first_chunk);
+  destination_->WaitForBody();
+  // The distilled page is sent before the whole body is read.
+  EXPECT_TRUE(resumed_);
+  EXPECT_FALSE(destination_->status());
+
+  WriteBody(second_chunk);
+  FinishBody();
+  destination_->WaitForCompletion();
+  ASSERT_TRUE(destination_->status());
+  EXPECT_EQ(net::OK, destination_->status()->error_code);
+
+  const std::string body = destination_->ReadBody();
+  EXPECT_TRUE(base::StartsWith(body, kDistilledPagePrefix,
+                               base::CompareCase::SENSITIVE));
+  EXPECT_TRUE(base::EndsWith(body, first_chunk + second_chunk,
+                             base::CompareCase::SENSITIVE));
+}
+
+TEST_F(SpeedReaderURLLoaderTest, SendsOriginalPageOnRewriterErrorBeforeOutput) {
+  const std::string original_body(2048, 'a');
+  fail_on_write_ = 0;
+  StartLoading();
+
+  WriteBody(original_body);
+  FinishBody();
+  destination_->WaitForCompletion();
+  ASSERT_TRUE(destination_->status());
+  EXPECT_EQ(net::OK, destination_->status()->error_code);
+  EXPECT_EQ(original_body, destination_->ReadBody());
+}
+
+TEST_F(SpeedReaderURLLoaderTest, FailsDistilledPageOnRewriterErrorAfterOutput) {
+  const std::string first_chunk(2048, 'a');
+  const std::string second_chunk(2048, 'b');
+  fail_on_write_ = 1;
+  StartLoading();
+
+  WriteBody(first_chunk);
+  destination_->WaitForBody();
+
+  WriteBody(second_chunk);
+  destination_->WaitForCompletion();
+  ASSERT_TRUE(destination_->status());
+  EXPECT_EQ(net::ERR_FAILED, destination_->status()->error_code);
+  // What was distilled before the error is still delivered, and nothing of
+  // the original page is mixed into it.
+  const std::string body = destination_->ReadBody();
+  EXPECT_TRUE(base::StartsWith(body, kDistilledPagePrefix,
+                               base::CompareCase::SENSITIVE));
+  EXPECT_TRUE(base::EndsWith(body, first_chunk, base::CompareCase::SENSITIVE));
+  // The rest of the body isn't read.
+  EXPECT_FALSE(IsSourceConnected());
+}
+
+TEST_F(SpeedReaderURLLoaderTest, StopsWhenDestinationDropsBody) {
+  StartLoading();
+
+  WriteBody(std::string(2048, 'a'));
+  destination_->WaitForBody();
+  destination_->DropBody();
+
+  WriteBody(std::string(2048, 'b'));
+  destination_->WaitForDisconnect();
+  EXPECT_FALSE(destination_->status());
+  EXPECT_FALSE(IsSourceConnected());
+}
+
+TEST_F(SpeedReaderURLLoaderTest, WaitsForRewriterWhenBodyCompletesFirst) {
+  const std::string original_body(2048, 'a');
+  block_rewriter_end_ = true;
+  StartLoading();
+
+  WriteBody(original_body);
+  FinishBody();
+  destination_->WaitForBody();
+  base::RunLoop().RunUntilIdle();
+  // The source has completed, but the rewriter hasn't ended yet.
+  EXPECT_FALSE(destination_->status());
+
+  rewriter_end_event_.Signal();
+  destination_->WaitForCompletion();
+  ASSERT_TRUE(destination_->status());
+  EXPECT_EQ(net::OK, destination_->status()->error_code);
+  EXPECT_TRUE(base::EndsWith(destination_->ReadBody(), original_body,
+                             base::CompareCase::SENSITIVE));
+}
+
+}  // namespace speedreader
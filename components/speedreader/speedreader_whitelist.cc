@@ -75,7 +75,7 @@ void SpeedreaderWhitelist::OnWhitelistFileReady(const base::FilePath& path,
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(
           &brave_component_updater::LoadDATFileData<speedreader::SpeedReader>,
-          path),
+          path, "Speedreader"),
       base::BindOnce(&SpeedreaderWhitelist::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
@@ -87,7 +87,8 @@ void SpeedreaderWhitelist::OnComponentReady(const std::string& component_id,
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(
           &brave_component_updater::LoadDATFileData<speedreader::SpeedReader>,
-          install_dir.Append(kDatFileVersion).Append(kDatFileName)),
+          install_dir.Append(kDatFileVersion).Append(kDatFileName),
+          "Speedreader"),
       base::BindOnce(&SpeedreaderWhitelist::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
@@ -96,13 +97,22 @@ bool SpeedreaderWhitelist::IsWhitelisted(const GURL& url) {
   return speedreader_->IsReadableURL(url.spec());
 }
 
-std::unique_ptr<Rewriter> SpeedreaderWhitelist::MakeRewriter(const GURL& url) {
-  return speedreader_->MakeRewriter(url.spec());
+RewriterType SpeedreaderWhitelist::GetRewriterType(const GURL& url) {
+  return speedreader_->RewriterTypeForURL(url.spec());
+}
+
+std::unique_ptr<Rewriter> SpeedreaderWhitelist::MakeRewriter(
+    const GURL& url,
+    RewriterType rewriter_type,
+    void (*output_sink)(const char*, size_t, void*),
+    void* output_sink_user_data) {
+  return speedreader_->MakeRewriter(url.spec(), rewriter_type, output_sink,
+                                    output_sink_user_data);
 }
 
 void SpeedreaderWhitelist::OnGetDATFileData(GetDATFileDataResult result) {
   VLOG(2) << "Speedreader loaded from DAT file";
-  speedreader_ = std::move(result.first);
+  speedreader_ = std::move(result.data);
 }
 
 }  // namespace speedreader
@@ -13,16 +13,12 @@
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
 
 namespace base {
 class FilePath;
 }
 
-namespace speedreader {
-class SpeedReader;
-class Rewriter;
-}  // namespace speedreader
-
 class GURL;
 
 namespace speedreader {
@@ -36,7 +32,15 @@ class SpeedreaderWhitelist : public brave_component_updater::BraveComponent {
   SpeedreaderWhitelist& operator=(const SpeedreaderWhitelist&) = delete;
 
   bool IsWhitelisted(const GURL& url);
-  std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  // Returns the kind of rewriter that will be used for |url|. Only
+  // |RewriterStreaming| can produce output before the whole page is written.
+  RewriterType GetRewriterType(const GURL& url);
+  // Creates a rewriter that passes every chunk of output to |output_sink|.
+  std::unique_ptr<Rewriter> MakeRewriter(
+      const GURL& url,
+      RewriterType rewriter_type,
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data);
 
  private:
   // brave_component_updater::BraveComponent:
@@ -0,0 +1,130 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Next value of the linear feedback shift register used to derive farbled
+// values from a seed.
+inline uint64_t lfsr_next(uint64_t v) {
+  const uint64_t zero = 0;
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+// Farbles WebAudio samples for a frame. Buffers are farbled a whole span at a
+// time. Each sample gets the farbled value for its index in the span, and the
+// maximum mode restarts its pseudo-random sequence at index 0.
+//
+// Defined entirely in this header: it is created in blink core but used from
+// blink modules, which is a separate component.
+class AudioFarbler {
+ public:
+  // Leaves samples untouched.
+  AudioFarbler() = default;
+
+  // Multiplies samples by |fudge_factor|.
+  static AudioFarbler Balanced(double fudge_factor) {
+    AudioFarbler farbler;
+    farbler.mode_ = Mode::kBalanced;
+    farbler.fudge_factor_ = fudge_factor;
+    return farbler;
+  }
+
+  // Replaces samples with pseudo-random values between 0 and 0.1 generated
+  // from |seed|.
+  static AudioFarbler Maximum(uint64_t seed) {
+    AudioFarbler farbler;
+    farbler.mode_ = Mode::kMaximum;
+    farbler.seed_ = seed;
+    farbler.state_ = seed;
+    return farbler;
+  }
+
+  bool IsEnabled() const { return mode_ != Mode::kOff; }
+
+  // Farbles the |count| samples at |data| in place.
+  void FarbleAudio(float* data, size_t count) const {
+    switch (mode_) {
+      case Mode::kOff:
+        break;
+      case Mode::kBalanced:
+        FarbleBalanced(fudge_factor_, data, count);
+        break;
+      case Mode::kMaximum:
+        FarbleMaximum(seed_, data, count);
+        break;
+    }
+  }
+
+  // Farbles the sample at |index| of a loop which cannot be expressed as a
+  // span. Indices must be visited in order, starting from 0.
+  inline float FarbleSample(float value, size_t index) {
+    switch (mode_) {
+      case Mode::kOff:
+        return value;
+      case Mode::kBalanced:
+        return value * fudge_factor_;
+      case Mode::kMaximum:
+        if (index == 0)
+          state_ = seed_;
+        state_ = lfsr_next(state_);
+        return ToMaximumSample(state_);
+    }
+    return value;
+  }
+
+ private:
+  enum class Mode { kOff, kBalanced, kMaximum };
+
+  // Number of pseudo-random values generated ahead of converting them to
+  // samples, which keeps the serial shift register loop apart from the
+  // conversion loop so that the latter can be vectorized.
+  static constexpr size_t kMaximumBlockSize = 256;
+
+  static float ToMaximumSample(uint64_t v) {
+    const double max_uint64_as_double = UINT64_MAX;
+    return (v / max_uint64_as_double) / 10;
+  }
+
+  static void FarbleBalanced(double fudge_factor, float* data, size_t count) {
+    // Plain loop without aliasing or calls, which the compiler turns into
+    // packed multiplications.
+    for (size_t i = 0; i < count; ++i)
+      data[i] = data[i] * fudge_factor;
+  }
+
+  static void FarbleMaximum(uint64_t seed, float* data, size_t count) {
+    const double max_uint64_as_double = UINT64_MAX;
+    uint64_t block[kMaximumBlockSize];
+    uint64_t v = seed;
+    for (size_t offset = 0; offset < count; offset += kMaximumBlockSize) {
+      const size_t block_size = count - offset < kMaximumBlockSize
+                                    ? count - offset
+                                    : kMaximumBlockSize;
+      for (size_t i = 0; i < block_size; ++i) {
+        v = lfsr_next(v);
+        block[i] = v;
+      }
+      float* destination = data + offset;
+      for (size_t i = 0; i < block_size; ++i)
+        destination[i] = (block[i] / max_uint64_as_double) / 10;
+    }
+  }
+
+  Mode mode_ = Mode::kOff;
+  double fudge_factor_ = 1.0;
+  uint64_t seed_ = 0;
+  // Position of FarbleSample() in the pseudo-random sequence.
+  uint64_t state_ = 0;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
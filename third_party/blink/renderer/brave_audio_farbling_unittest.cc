@@ -0,0 +1,114 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave::AudioFarbler;
+
+namespace {
+
+using AudioFarblingCallback = base::RepeatingCallback<float(float, size_t)>;
+
+const double kFudgeFactor = 0.99;
+const uint64_t kSeed = 0x1234567890abcdefULL;
+
+// Per-sample callbacks, as the buffers were farbled before AudioFarbler.
+float ConstantMultiplier(double fudge_factor, float value, size_t index) {
+  return value * fudge_factor;
+}
+
+float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
+  static uint64_t v;
+  if (index == 0) {
+    v = seed;
+  }
+  v = brave::lfsr_next(v);
+  const double max_uint64_as_double = UINT64_MAX;
+  return (v / max_uint64_as_double) / 10;
+}
+
+std::vector<float> BuildSamples(size_t count) {
+  std::vector<float> samples(count);
+  for (size_t i = 0; i < count; ++i)
+    samples[i] = static_cast<float>(i % 2000) / 1000.0f - 1.0f;
+  return samples;
+}
+
+void FarbleWithCallback(const AudioFarblingCallback& callback,
+                        std::vector<float>* samples) {
+  for (size_t i = 0; i < samples->size(); ++i)
+    (*samples)[i] = callback.Run((*samples)[i], i);
+}
+
+}  // namespace
+
+TEST(BraveAudioFarblingTest, OffLeavesSamplesUntouched) {
+  const std::vector<float> expected = BuildSamples(1000);
+  std::vector<float> samples = expected;
+
+  AudioFarbler farbler;
+  EXPECT_FALSE(farbler.IsEnabled());
+  farbler.FarbleAudio(samples.data(), samples.size());
+  EXPECT_EQ(expected, samples);
+  EXPECT_EQ(0.5f, farbler.FarbleSample(0.5f, 0));
+}
+
+TEST(BraveAudioFarblingTest, BalancedMatchesPerSampleCallback) {
+  std::vector<float> expected = BuildSamples(1001);
+  std::vector<float> samples = expected;
+  std::vector<float> per_sample = expected;
+
+  FarbleWithCallback(base::BindRepeating(&ConstantMultiplier, kFudgeFactor),
+                     &expected);
+  AudioFarbler farbler = AudioFarbler::Balanced(kFudgeFactor);
+  EXPECT_TRUE(farbler.IsEnabled());
+  farbler.FarbleAudio(samples.data(), samples.size());
+  for (size_t i = 0; i < per_sample.size(); ++i)
+    per_sample[i] = farbler.FarbleSample(per_sample[i], i);
+
+  EXPECT_EQ(expected, samples);
+  EXPECT_EQ(expected, per_sample);
+}
+
+TEST(BraveAudioFarblingTest, MaximumMatchesPerSampleCallback) {
+  // Spans more than one block of pseudo-random values.
+  std::vector<float> expected = BuildSamples(1001);
+  std::vector<float> samples = expected;
+  std::vector<float> per_sample = expected;
+
+  FarbleWithCallback(base::BindRepeating(&PseudoRandomSequence, kSeed),
+                     &expected);
+  AudioFarbler farbler = AudioFarbler::Maximum(kSeed);
+  farbler.FarbleAudio(samples.data(), samples.size());
+  for (size_t i = 0; i < per_sample.size(); ++i)
+    per_sample[i] = farbler.FarbleSample(per_sample[i], i);
+
+  EXPECT_EQ(expected, samples);
+  EXPECT_EQ(expected, per_sample);
+}
+
+TEST(BraveAudioFarblingTest, MaximumRestartsSequenceForEachBuffer) {
+  std::vector<float> first = BuildSamples(100);
+  std::vector<float> second = BuildSamples(100);
+
+  AudioFarbler farbler = AudioFarbler::Maximum(kSeed);
+  farbler.FarbleAudio(first.data(), first.size());
+  farbler.FarbleAudio(second.data(), second.size());
+  EXPECT_EQ(first, second);
+
+  for (size_t i = 0; i < first.size(); ++i)
+    EXPECT_EQ(first[i], farbler.FarbleSample(0.0f, i));
+  for (size_t i = 0; i < first.size(); ++i)
+    EXPECT_EQ(first[i], farbler.FarbleSample(0.0f, i));
+}
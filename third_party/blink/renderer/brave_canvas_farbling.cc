@@ -0,0 +1,93 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <string.h>
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t kMultiplier = 0x9fb21c651e98df25ULL;
+constexpr uint64_t kGoldenRatio = 0x9e3779b97f4a7c15ULL;
+
+// Number of independent accumulators in HashCanvasPixels(), which lets the
+// multiplications of consecutive words overlap.
+constexpr size_t kHashLanes = 4;
+
+uint64_t LoadWord(const uint8_t* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof word);
+  return word;
+}
+
+uint64_t Mix(uint64_t v) {
+  v ^= v >> 32;
+  v *= kMultiplier;
+  v ^= v >> 29;
+  v *= kMultiplier;
+  return v ^ (v >> 32);
+}
+
+}  // namespace
+
+uint64_t HashCanvasPixels(uint64_t key, const uint8_t* data, size_t size) {
+  uint64_t lanes[kHashLanes];
+  for (size_t i = 0; i < kHashLanes; ++i)
+    lanes[i] = Mix(key + (i + 1) * kGoldenRatio);
+
+  const size_t kBlockSize = kHashLanes * sizeof(uint64_t);
+  size_t offset = 0;
+  for (; offset + kBlockSize <= size; offset += kBlockSize) {
+    for (size_t i = 0; i < kHashLanes; ++i) {
+      lanes[i] = (lanes[i] ^ LoadWord(data + offset + i * sizeof(uint64_t))) *
+                 kMultiplier;
+      lanes[i] ^= lanes[i] >> 31;
+    }
+  }
+
+  uint64_t tail[kHashLanes] = {};
+  if (offset < size)
+    memcpy(tail, data + offset, size - offset);
+  uint64_t hash = key ^ size;
+  for (size_t i = 0; i < kHashLanes; ++i)
+    hash = Mix(hash ^ lanes[i] ^ Mix(tail[i] + i));
+  return hash;
+}
+
+void PerturbCanvasBalanced(uint64_t content_hash,
+                           uint8_t channel,
+                           uint8_t* pixels,
+                           size_t pixel_count) {
+  if (!pixel_count)
+    return;
+  uint64_t v = content_hash;
+  // Each of the 256 bits decides whether the next chosen pixel is flipped.
+  for (uint64_t i = 1; i <= 4; ++i) {
+    uint64_t bits = Mix(content_hash + i * kGoldenRatio);
+    for (int j = 0; j < 64; ++j) {
+      const size_t pixel_index = 4 * (v % pixel_count) + channel;
+      pixels[pixel_index] ^= bits & 0x1;
+      bits >>= 1;
+      v = lfsr_next(v);
+    }
+  }
+}
+
+void PerturbCanvasMax(uint64_t seed, uint8_t* data, size_t size) {
+  uint64_t v = seed;
+  size_t offset = 0;
+  for (; offset + sizeof v <= size; offset += sizeof v) {
+    memcpy(data + offset, &v, sizeof v);
+    v = lfsr_next(v);
+  }
+  if (offset < size)
+    memcpy(data + offset, &v, size - offset);
+}
+
+}  // namespace brave
@@ -0,0 +1,34 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Keyed 64-bit hash of the |size| bytes at |data|, used to seed the balanced
+// canvas perturbation. It is not a MAC. It only has to change with the canvas
+// contents and stay unpredictable without |key|, and it is cheap enough to run
+// over every readback of a large canvas.
+uint64_t HashCanvasPixels(uint64_t key, const uint8_t* data, size_t size);
+
+// Flips the low bit of up to 256 values of |channel| (0 to 2) in the
+// |pixel_count| RGBA pixels at |pixels|. The pixels and bits are chosen from
+// |content_hash|.
+void PerturbCanvasBalanced(uint64_t content_hash,
+                           uint8_t channel,
+                           uint8_t* pixels,
+                           size_t pixel_count);
+
+// Overwrites the |size| bytes at |data| with a pseudo-random sequence
+// generated from |seed|, 8 bytes per step.
+void PerturbCanvasMax(uint64_t seed, uint8_t* data, size_t size);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
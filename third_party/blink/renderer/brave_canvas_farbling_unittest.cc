@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const uint64_t kKey = 0x1234567890abcdefULL;
+
+std::vector<uint8_t> BuildPixels(size_t pixel_count) {
+  std::vector<uint8_t> pixels(4 * pixel_count);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<uint8_t>((i * 31) ^ (i >> 7));
+  return pixels;
+}
+
+}  // namespace
+
+TEST(BraveCanvasFarblingTest, HashDependsOnKeyAndEveryByte) {
+  std::vector<uint8_t> pixels = BuildPixels(1001);
+  const uint64_t hash =
+      brave::HashCanvasPixels(kKey, pixels.data(), pixels.size());
+
+  EXPECT_EQ(hash, brave::HashCanvasPixels(kKey, pixels.data(), pixels.size()));
+  EXPECT_NE(hash,
+            brave::HashCanvasPixels(kKey + 1, pixels.data(), pixels.size()));
+  EXPECT_NE(hash,
+            brave::HashCanvasPixels(kKey, pixels.data(), pixels.size() - 1));
+
+  // Flip a byte in the block loop and one in the tail.
+  for (size_t index : {size_t(0), pixels.size() / 2, pixels.size() - 1}) {
+    pixels[index] ^= 1;
+    EXPECT_NE(hash,
+              brave::HashCanvasPixels(kKey, pixels.data(), pixels.size()))
+        << index;
+    pixels[index] ^= 1;
+  }
+}
+
+TEST(BraveCanvasFarblingTest, BalancedOnlyTouchesLowBitOfChannel) {
+  const std::vector<uint8_t> original = BuildPixels(10000);
+  std::vector<uint8_t> pixels = original;
+  const uint8_t channel = 1;
+
+  brave::PerturbCanvasBalanced(kKey, channel, pixels.data(), 10000);
+
+  size_t changed = 0;
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    if (pixels[i] == original[i])
+      continue;
+    ++changed;
+    EXPECT_EQ(channel, i % 4);
+    EXPECT_EQ(1, pixels[i] ^ original[i]);
+  }
+  EXPECT_GT(changed, 0u);
+  EXPECT_LE(changed, 256u);
+
+  std::vector<uint8_t> again = original;
+  brave::PerturbCanvasBalanced(kKey, channel, again.data(), 10000);
+  EXPECT_EQ(pixels, again);
+}
+
+TEST(BraveCanvasFarblingTest, BalancedIgnoresEmptyCanvas) {
+  brave::PerturbCanvasBalanced(kKey, 0, nullptr, 0);
+}
+
+TEST(BraveCanvasFarblingTest, MaxWritesOneLfsrStepPerEightBytes) {
+  // Not a multiple of 8, so that the tail is covered as well.
+  std::vector<uint8_t> pixels(4 * 11 + 2);
+  brave::PerturbCanvasMax(kKey, pixels.data(), pixels.size());
+
+  uint64_t v = kKey;
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    if (i && i % 8 == 0)
+      v = brave::lfsr_next(v);
+    EXPECT_EQ(static_cast<uint8_t>(v >> (8 * (i % 8))), pixels[i]) << i;
+  }
+}